@@ -16,9 +16,6 @@ public:
 
   ~AbsoluteEncoder() noexcept override = default;
 
-  double toRad(int32_t iu) const override;
-  double getRadPerBit() const override;
-
   /**
    * Converts radians to encoder Internal Units (IU).
    */
@@ -54,7 +51,6 @@ public:
   static constexpr double MAX_RANGE_DIFFERENCE = 0.05;
 
 private:
-  int32_t zero_position_iu_ = 0;
   int32_t lower_limit_iu_ = 0;
   int32_t upper_limit_iu_ = 0;
   int32_t lower_soft_limit_iu_ = 0;
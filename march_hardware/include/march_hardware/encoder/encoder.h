@@ -13,8 +13,6 @@ namespace march
 class Encoder
 {
 public:
-  explicit Encoder(size_t number_of_bits);
-
   virtual ~Encoder() noexcept = default;
 
   /**
@@ -49,19 +47,51 @@ public:
    */
   double getVelocityRad(const PdoSlaveInterface& pdo, uint8_t byte_offset) const;
 
+  /**
+   * Converts a velocity read from the slave, which is a fixed point 16.16 number of IU per velocity sample,
+   * to Internal Units per second (IU/s).
+   */
+  static double toVelocityIU(int32_t velocity);
+
   /**
    * Converts encoder Internal Units (IU) to radians.
-   * This is a pure virtual function and must be implemented by subclasses,
-   * since each type of encoder has a different way of calculating radians.
    */
-  virtual double toRad(int32_t iu) const = 0;
+  double toRad(int32_t iu) const
+  {
+    return (iu - this->zero_position_iu_) * this->rad_per_bit_;
+  }
+
+  /**
+   * Converts a velocity read from the slave, see toVelocityIU(), to radians per second.
+   */
+  double toVelocityRad(int32_t velocity) const
+  {
+    return velocity * this->rad_per_second_per_velocity_;
+  }
 
   /**
    * Returns the radians corresponding to the distance between two bits.
-   * This is a pure virtual function and must be implemented by subclasses,
-   * since each type of encoder has a different way of calculating radians.
    */
-  virtual double getRadPerBit() const = 0;
+  double getRadPerBit() const
+  {
+    return this->rad_per_bit_;
+  }
+
+  /**
+   * Returns the radians per second corresponding to one unit of velocity read from the slave.
+   */
+  double getRadPerSecondPerVelocity() const
+  {
+    return this->rad_per_second_per_velocity_;
+  }
+
+  /**
+   * Returns the position in IU that corresponds to 0 radians.
+   */
+  int32_t getZeroPositionIU() const
+  {
+    return this->zero_position_iu_;
+  }
 
   size_t getTotalPositions() const;
 
@@ -76,6 +106,17 @@ public:
 
   static constexpr double PI_2 = 2 * M_PI;
 
+protected:
+  /**
+   * The conversion factors are computed once here, so converting a sample is a single multiply.
+   * @param number_of_bits The resolution of the encoder
+   * @param transmission Amount of encoder revolutions per revolution of the joint
+   */
+  Encoder(size_t number_of_bits, double transmission);
+
+  // Position in IU that corresponds to 0 radians
+  int32_t zero_position_iu_ = 0;
+
 private:
   /**
    * Returns the total number of positions possible on an encoder
@@ -89,6 +130,8 @@ private:
   static size_t calculateTotalPositions(size_t number_of_bits);
 
   size_t total_positions_ = 0;
+  double rad_per_bit_ = 0.0;
+  double rad_per_second_per_velocity_ = 0.0;
 };
 }  // namespace march
 
@@ -32,6 +32,11 @@ enum class ErrorType
   INIT_URDF_FAILED = 120,
   INVALID_SW_STRING = 121,
   SLAVE_LOST_TIMOUT = 122,
+  IO_MAP_OVERFLOW = 123,
+  PREPARE_ACTUATION_TIMEOUT = 124,
+  SLAVE_RESET_FAILED = 125,
+  ETHERCAT_LOOP_STOPPED = 126,
+  INVALID_ETHERCAT_CONFIGURATION = 127,
   UNKNOWN = 999,
 };
 
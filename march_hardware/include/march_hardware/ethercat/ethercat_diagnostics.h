@@ -0,0 +1,54 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ETHERCAT_ETHERCAT_DIAGNOSTICS_H
+#define MARCH_HARDWARE_ETHERCAT_ETHERCAT_DIAGNOSTICS_H
+#include <cstdint>
+#include <vector>
+
+namespace march
+{
+/**
+ * Process data counters of a group of slaves that share a frame.
+ */
+struct EthercatGroupDiagnostics
+{
+  // Cycles in which the process data was sent
+  uint64_t cycles = 0;
+  // Cycles in which no process data was sent, since a slave was lost
+  uint64_t skipped_cycles = 0;
+  // Cycles in which the frame did not return
+  uint64_t lost_frames = 0;
+  // Cycles in which the frame returned with a lower working counter than expected
+  uint64_t working_counter_shortfalls = 0;
+  int last_working_counter = 0;
+  int expected_working_counter = 0;
+};
+
+/**
+ * Counters of a single slave, observed by the supervisor thread.
+ */
+struct EthercatSlaveDiagnostics
+{
+  uint16_t slave_index = 0;
+  // Last observed AL state and AL status code
+  uint16_t al_state = 0;
+  uint16_t al_status_code = 0;
+  // Amount of times the AL state was observed to be different from the previous observation
+  uint32_t al_state_changes = 0;
+  // Amount of slave checks in which the slave was not operational
+  uint32_t not_operational = 0;
+  uint32_t recovery_attempts = 0;
+  uint32_t recoveries = 0;
+  // Sum of the invalid frame and RX error counters of all ports of the EtherCAT slave controller
+  uint32_t rx_errors = 0;
+  // Sum of the lost link counters of all ports of the EtherCAT slave controller
+  uint32_t lost_links = 0;
+};
+
+struct EthercatDiagnostics
+{
+  std::vector<EthercatGroupDiagnostics> groups;
+  // Diagnostics of slave 1 up to and including the maximum configured slave index
+  std::vector<EthercatSlaveDiagnostics> slaves;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_ETHERCAT_ETHERCAT_DIAGNOSTICS_H
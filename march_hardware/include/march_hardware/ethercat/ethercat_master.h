@@ -1,30 +1,54 @@
 // Copyright 2019 Project March.
 #ifndef MARCH_HARDWARE_ETHERCAT_ETHERCATMASTER_H
 #define MARCH_HARDWARE_ETHERCAT_ETHERCATMASTER_H
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <exception>
+#include <functional>
+#include <memory>
 #include <vector>
 #include <string>
 #include <thread>
-#include <mutex>
-#include <condition_variable>
 
+#include <march_hardware/ethercat/ethercat_diagnostics.h>
+#include <march_hardware/ethercat/io_map.h>
+#include <march_hardware/ethercat/latency_histogram.h>
+#include <march_hardware/ethercat/process_image.h>
 #include <march_hardware/joint.h>
+#include <march_hardware/realtime_config.h>
+#include <march_hardware/startup_timeline.h>
 
 namespace march
 {
 /**
  * Base class of the ethercat master supported with the SOEM library
  * @param ifname Network interface name, check ifconfig.
- * @param io_map Holds the mapping of the SOEM message.
+ * @param io_map Holds the mapping of the SOEM message, sized to the process data of the slaves.
  * @param expected_working_counter The expected working counter of the ethercat train.
- * @param cycle_time_ms The ethercat cycle time.
+ * @param cycle_time_us The ethercat cycle time in microseconds.
  * @param max_slave_index The maximum amount of slaves connected to the train.
+ * @param spin_time_us The part of every cycle in microseconds that is busy waited instead of slept,
+ *                     to compensate for the wake-up latency of the kernel. 0 disables spinning.
+ *                     Must be less than the cycle time.
+ * @param slow_group_divider When larger than 1, only the IMotionCubes are exchanged every cycle and all other
+ *                           slaves are exchanged in a separate group once every this many cycles. This needs
+ *                           SOEM built with an EC_MAXGROUP larger than SLOW_GROUP, while stock SOEM has 2.
+ *                           The slow group period of divider * cycle time may not exceed SLOW_GROUP_MAX_PERIOD.
  */
 class EthercatMaster
 {
 public:
-  EthercatMaster(std::string ifname, int max_slave_index, int cycle_time, int slave_timeout);
+  using CycleCallback = std::function<void()>;
+
+  /**
+   * @throws HardwareException When the spin time is negative or not less than the cycle time,
+   *                           when the slow group period exceeds SLOW_GROUP_MAX_PERIOD,
+   *                           or when a slow group is configured while SOEM has no more than SLOW_GROUP groups
+   */
+  EthercatMaster(std::string ifname, int max_slave_index, int cycle_time_us, int slave_timeout, int spin_time_us = 0,
+                 int slow_group_divider = 1);
   ~EthercatMaster();
 
   /* Delete copy constructor/assignment since the member thread can not be copied */
@@ -36,28 +60,121 @@ public:
   EthercatMaster& operator=(EthercatMaster&&) = delete;
 
   bool isOperational() const;
-  void waitForPdo();
+
+  /**
+   * Commits the outputs written since the previous call and blocks until the ethercat loop
+   * received new inputs, which are then consistent until the next call.
+   * On the first call the slave process data is moved from the io map to an application copy
+   * that is exchanged with the ethercat loop through the process image. Before that, slaves
+   * read and write the io map directly, which is only used during start-up.
+   * Inputs are only handed over from exchanges in which the fast group returned the expected working counter.
+   * A shortfall of the slow group is only reported, so its inputs may be older than those of the fast group.
+   * @return true when new inputs were acquired, false when the loop was stopped and the previous inputs remain
+   */
+  bool waitForPdo();
+
+  /**
+   * Blocks until the ethercat loop exchanged the PDO once more, without starting the process image handoff.
+   * Used during start-up to step the slaves once per cycle while they still access the io map directly.
+   * Behaves like waitForPdo() once the handoff has started.
+   * @return true when the PDO was exchanged with the expected working counters, false when the loop was stopped
+   * @throws std::logic_error When a cycle callback is set
+   */
+  bool waitForCycle();
+
+  /**
+   * Runs the given callback in the ethercat loop directly after every received PDO, instead of handing the PDO
+   * over to a thread calling waitForPdo(). The outputs written by the callback are sent in the next cycle, without
+   * waking another thread in between. Slaves read and write the io map directly in this mode. The callback only
+   * runs after exchanges in which the fast group returned the expected working counter, so the inputs of the
+   * IMotionCubes are always new.
+   * An exception thrown by the callback stops the ethercat loop and is available from getLastException().
+   * @throws std::logic_error When a callback was already set or waitForPdo() was already called
+   */
+  void setCycleCallback(CycleCallback callback);
 
   std::exception_ptr getLastException() const noexcept;
 
   /**
-   * Returns the cycle time in milliseconds.
+   * Sets the real-time settings the ethercat thread applies to itself before its first cycle.
+   * By default the thread is only scheduled with SCHED_FIFO at THREAD_PRIORITY.
+   * @throws std::logic_error When the ethercat loop is running
+   */
+  void setRealtimeConfig(RealtimeConfig config);
+
+  /**
+   * Returns the cycle time in microseconds.
    */
   int getCycleTime() const;
 
+  /**
+   * Returns the duration between the last two wake-ups of the ethercat loop.
+   */
+  std::chrono::nanoseconds getAchievedPeriod() const;
+
+  /**
+   * Returns how late the ethercat loop woke up relative to its absolute deadline in the last cycle.
+   */
+  std::chrono::nanoseconds getPhaseError() const;
+
+  /**
+   * Returns the timing statistics of every phase of the ethercat loop since it was started.
+   * Can be called from any thread without blocking the ethercat loop.
+   */
+  EthercatCycleTimings getCycleTimings() const;
+
+  /**
+   * Returns a snapshot of the process data counters and the counters of every slave since construction.
+   * Can be called from any thread without blocking the ethercat loop.
+   */
+  EthercatDiagnostics getDiagnostics() const;
+
   /**
    * Initializes the ethercat train and starts a thread for the loop.
-   * @throws HardwareException If not the configured amount of slaves was found
+   * Only the IMotionCubes that downloaded a new setup are reset and initialized again, the other slaves are
+   * initialized once.
+   * @param reset_imc resets all IMotionCubes instead of only the ones that downloaded a new setup
+   * @throws HardwareException If not the configured amount of slaves was found, a reset slave did not return
    *                           or they did not all reach operational state
    */
-  bool start(std::vector<Joint>& joints);
+  void start(std::vector<Joint>& joints, bool reset_imc = false);
+
+  /**
+   * Returns the timeline of the last start(), to which the phases after start() can be added as well.
+   */
+  StartupTimeline& getStartupTimeline();
 
   /**
-   * Stops the ethercat loop and joins the thread.
+   * Stops the ethercat loop and joins the thread. When called from the cycle callback,
+   * the loop stops after the callback returns.
    */
   void stop();
 
   static const int THREAD_PRIORITY = 40;
+  // Lower than the ethercat loop, so slave recovery never preempts the process data exchange
+  static const int SUPERVISOR_THREAD_PRIORITY = 30;
+  static constexpr std::chrono::milliseconds SUPERVISOR_PERIOD{ 10 };
+  // Period in which the supervisor reads the state and error counters of all slaves
+  static constexpr std::chrono::seconds DIAGNOSTICS_PERIOD{ 1 };
+  // Time a reset slave gets to reboot and return to pre-operational state
+  static constexpr std::chrono::seconds SLAVE_RESET_TIMEOUT{ 10 };
+  static constexpr std::chrono::milliseconds SLAVE_RESET_POLL_PERIOD{ 100 };
+
+  // Process data groups of SOEM. Group 0 maps all slaves, so it is only used when all slaves are exchanged
+  // every cycle. With a slow group divider larger than 1 the slaves are split over the fast and slow group.
+  static const int ALL_SLAVES_GROUP = 0;
+  static const int FAST_GROUP = 1;
+  static const int SLOW_GROUP = 2;
+  static const int MAX_GROUP_COUNT = 2;
+  // The watchdog of the slow group slaves is not programmed, so it keeps the ESC default of 100 ms.
+  // Half of that leaves room for a late cycle before the slaves drop their outputs.
+  static constexpr std::chrono::milliseconds SLOW_GROUP_MAX_PERIOD{ 50 };
+
+  // Largest io map that is allocated for the process data of all slaves
+  static const size_t MAX_IO_MAP_SIZE = 65536;
+
+  // Amount of buckets of the timing histograms, which span two cycle times
+  static const size_t HISTOGRAM_BUCKET_COUNT = 2000;
 
 private:
   /**
@@ -68,26 +185,104 @@ private:
   /**
    * Configures the found slaves to operational state.
    */
-  bool ethercatSlaveInitiation(std::vector<Joint>& joints);
+  void ethercatSlaveInitiation(std::vector<Joint>& joints, bool reset_imc);
+
+  /**
+   * Writes the initial settings of the given joints through SDOs, one joint after the other.
+   * @returns the joints of which the IMotionCube must be reset, because a new setup was downloaded to it
+   * @throws HardwareException When the initialization of any of the joints failed
+   */
+  std::vector<Joint*> initializeJoints(const std::vector<Joint*>& joints);
+
+  /**
+   * Resets the IMotionCubes of the given joints and initializes them again once they are back in
+   * pre-operational state. The other slaves are left untouched.
+   * @throws HardwareException When a slave did not return within SLAVE_RESET_TIMEOUT
+   */
+  void resetJoints(const std::vector<Joint*>& joints);
+
+  /**
+   * Waits until the given slave rebooted after a reset, reprograms its mailbox and returns it to pre-operational
+   * state. The process data is left to configureGroups().
+   * @returns true when the slave reached pre-operational state within SLAVE_RESET_TIMEOUT
+   */
+  bool recoverResetSlave(int slave);
 
   /**
-   * The ethercat train PDO loop. If the working counter is lower than
-   * expected 5% of the time, the program displays an error.
+   * Returns the SOEM group of the given process data group, of which the fast group is 0.
+   */
+  int getSoemGroup(int group) const;
+
+  /**
+   * Assigns the slaves to their process data group and maps the groups into an io map sized to their process data.
+   * @throws HardwareException When the process data does not fit in MAX_IO_MAP_SIZE
+   */
+  void configureGroups(const std::vector<Joint>& joints);
+
+  /**
+   * Exchanges the process data of all groups once, used during start-up.
+   */
+  void sendReceiveAllGroups();
+
+  /**
+   * The ethercat train PDO loop. Every cycle is started on an absolute deadline
+   * on CLOCK_MONOTONIC, so that wake-up latency does not accumulate into drift.
+   * The loop only exchanges process data, the slaves are supervised by supervisorLoop().
+   * If the cycle time is not achieved 5% of the time, the program displays a warning.
    */
   void ethercatLoop();
 
   /**
-   * Sends the PDO and receives the working counter and check if this is lower than expected.
+   * Points the process data of all slaves to the application copy of the io map.
+   */
+  void startProcessImageHandoff();
+
+  /**
+   * Loop of the supervisor thread. Checks the state of the slaves and attempts to recover them
+   * whenever the ethercat loop received a lower working counter than expected, or a slave is lost.
+   * Runs outside of the ethercat loop, since reading the slave states and recovering slaves
+   * blocks for multiple cycles.
+   */
+  void supervisorLoop();
+
+  /**
+   * Sleeps until the given absolute deadline on CLOCK_MONOTONIC. The last
+   * spin_time_ of the sleep is busy waited to reduce wake-up jitter.
    *
-   * @returns true if and only if all PDOs have been successfully sent and received, otherwise false.
+   * @param deadline absolute time since the epoch of CLOCK_MONOTONIC
+   * @returns the time at which the thread continued
    */
-  bool sendReceivePdo();
+  std::chrono::nanoseconds sleepUntil(std::chrono::nanoseconds deadline) const;
+
+  /**
+   * Returns the bucket width of the timing histograms, such that they span two cycle times.
+   */
+  std::chrono::nanoseconds getHistogramBucketWidth() const;
+
+  /**
+   * Sends the PDO of every group and receives its working counter, one group after the other, and checks if it is
+   * lower than expected. A lower working counter requests the supervisor thread to check the slaves.
+   *
+   * @param group_count the amount of groups to exchange, starting at the fast group
+   * @returns true if and only if the PDO of the fast group has been successfully sent and received, otherwise false.
+   */
+  bool sendReceivePdo(int group_count);
 
   /**
    * Checks if all the slaves are connected and in operational state.
    */
   void monitorSlaveConnection();
 
+  /**
+   * Updates the diagnostics of the slaves with their states read by ec_readstate().
+   */
+  void updateSlaveStates();
+
+  /**
+   * Reads the RX error and lost link counters of the EtherCAT slave controllers of all slaves.
+   */
+  void updateSlaveErrorCounters();
+
   /**
    * Attempts to recover a slave to operational state.
    *
@@ -101,32 +296,81 @@ private:
   void closeEthercat();
 
   /**
-   * Sets the ethercat thread priority and scheduling
+   * Sets the thread priority and scheduling
    * to SCHED_FIFO using pthread.
    * Note: Only works on POSIX compliant systems.
    *
+   * @param thread the thread to set the priority of
    * @param priority a pthread priority value between 1 and 99 for SCHED_FIFO threads.
    */
-  void setThreadPriority(int priority);
+  static void setThreadPriority(std::thread& thread, int priority);
 
   std::atomic<bool> is_operational_;
 
   const std::string ifname_;
   const int max_slave_index_;
-  const int cycle_time_ms_;
+  const std::chrono::microseconds cycle_time_;
+  const std::chrono::microseconds spin_time_;
+  const int slow_group_divider_;
+  const int group_count_;
+  RealtimeConfig realtime_config_;
+  StartupTimeline startup_timeline_;
 
-  std::mutex wait_on_pdo_condition_mutex_;
-  std::condition_variable wait_on_pdo_condition_var_;
-  bool pdo_received_ = false;
+  std::atomic<int64_t> achieved_period_ns_;
+  std::atomic<int64_t> phase_error_ns_;
 
-  char io_map_[4096] = { 0 };
-  int expected_working_counter_ = 0;
+  LatencyHistogram send_receive_histogram_;
+  LatencyHistogram monitor_slaves_histogram_;
+  LatencyHistogram publish_histogram_;
+  LatencyHistogram cycle_callback_histogram_;
+  LatencyHistogram sleep_overshoot_histogram_;
+  LatencyHistogram period_histogram_;
 
-  int latest_lost_slave_ = -1;
+  ProcessImage process_image_;
+  // Only used by the thread calling waitForPdo()
+  bool process_image_handoff_ = false;
+  uint64_t last_input_sequence_ = 0;
+
+  IoMap io_map_;
+  // Copy of the io map that is read and written by the control thread once the process image handoff started
+  IoMap application_map_;
+  std::array<int, MAX_GROUP_COUNT> expected_working_counters_ = { { 0 } };
+
+  std::atomic<int> latest_lost_slave_{ -1 };
+  std::atomic<bool> slave_check_requested_{ false };
+
+  CycleCallback cycle_callback_;
+  std::atomic<bool> has_cycle_callback_{ false };
   const int slave_watchdog_timeout_;
   std::chrono::high_resolution_clock::time_point valid_slaves_timestamp_ms_;
 
+  // Written by the ethercat loop
+  struct GroupCounters
+  {
+    std::atomic<uint64_t> cycles{ 0 };
+    std::atomic<uint64_t> skipped_cycles{ 0 };
+    std::atomic<uint64_t> lost_frames{ 0 };
+    std::atomic<uint64_t> working_counter_shortfalls{ 0 };
+    std::atomic<int> last_working_counter{ 0 };
+  };
+  // Written by the supervisor thread
+  struct SlaveCounters
+  {
+    std::atomic<uint16_t> al_state{ 0 };
+    std::atomic<uint16_t> al_status_code{ 0 };
+    std::atomic<uint32_t> al_state_changes{ 0 };
+    std::atomic<uint32_t> not_operational{ 0 };
+    std::atomic<uint32_t> recovery_attempts{ 0 };
+    std::atomic<uint32_t> recoveries{ 0 };
+    std::atomic<uint32_t> rx_errors{ 0 };
+    std::atomic<uint32_t> lost_links{ 0 };
+  };
+  std::array<GroupCounters, MAX_GROUP_COUNT> group_counters_;
+  // Indexed by slave index, allocated up to and including the maximum slave index
+  std::unique_ptr<SlaveCounters[]> slave_counters_;
+
   std::thread ethercat_thread_;
+  std::thread supervisor_thread_;
   std::exception_ptr last_exception_;
 };
 
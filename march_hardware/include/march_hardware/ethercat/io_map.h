@@ -0,0 +1,51 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ETHERCAT_IO_MAP_H
+#define MARCH_HARDWARE_ETHERCAT_IO_MAP_H
+#include <cstddef>
+#include <cstdint>
+
+namespace march
+{
+/**
+ * Buffer holding the process data of the EtherCAT slaves.
+ * The buffer is aligned to a cache line and locked in memory, so that
+ * accessing the process data never causes a page fault in the ethercat loop.
+ */
+class IoMap
+{
+public:
+  IoMap() = default;
+  ~IoMap();
+
+  /* Delete copy and move constructor/assignment since the buffer is owned */
+  IoMap(const IoMap&) = delete;
+  IoMap& operator=(const IoMap&) = delete;
+  IoMap(IoMap&&) = delete;
+  IoMap& operator=(IoMap&&) = delete;
+
+  /**
+   * Replaces the buffer by a zeroed buffer of at least the given size.
+   * Must not be called while the process data is in use.
+   * @throws std::bad_alloc When the buffer could not be allocated
+   */
+  void allocate(size_t size);
+
+  uint8_t* data() const;
+  size_t size() const;
+
+  /**
+   * Returns whether the buffer could be locked in memory, which can fail due to RLIMIT_MEMLOCK.
+   */
+  bool isLocked() const;
+
+  static const size_t ALIGNMENT = 64;
+
+private:
+  void release();
+
+  uint8_t* data_ = nullptr;
+  size_t size_ = 0;
+  bool locked_ = false;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_ETHERCAT_IO_MAP_H
@@ -0,0 +1,96 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ETHERCAT_LATENCY_HISTOGRAM_H
+#define MARCH_HARDWARE_ETHERCAT_LATENCY_HISTOGRAM_H
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace march
+{
+/**
+ * Summary of the durations recorded in a LatencyHistogram.
+ * Percentiles are the upper bound of the bucket they fall in, limited by max.
+ */
+struct LatencyStatistics
+{
+  uint64_t count = 0;
+  std::chrono::nanoseconds min{ 0 };
+  std::chrono::nanoseconds max{ 0 };
+  std::chrono::nanoseconds mean{ 0 };
+  std::chrono::nanoseconds p50{ 0 };
+  std::chrono::nanoseconds p90{ 0 };
+  std::chrono::nanoseconds p99{ 0 };
+  std::chrono::nanoseconds p999{ 0 };
+};
+
+/**
+ * Histogram of durations with a fixed amount of equally sized buckets.
+ * Durations beyond the range of the buckets are counted in an overflow bucket.
+ *
+ * Recording is wait-free and allocation free, so it can be done from a real-time thread.
+ * There must only be a single thread recording, but any amount of threads can read
+ * the statistics concurrently. Since the buckets are read one by one, the statistics
+ * may be off by the samples recorded while reading.
+ */
+class LatencyHistogram
+{
+public:
+  /**
+   * @param bucket_width the range of durations counted in a single bucket
+   * @param bucket_count the amount of buckets, excluding the overflow bucket
+   * @throws std::invalid_argument when the bucket width or the amount of buckets is zero
+   */
+  LatencyHistogram(std::chrono::nanoseconds bucket_width, size_t bucket_count);
+
+  /* Delete copy and move constructor/assignment since atomics cannot be copied or moved */
+  LatencyHistogram(const LatencyHistogram&) = delete;
+  LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+  LatencyHistogram(LatencyHistogram&&) = delete;
+  LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+
+  /**
+   * Records a single duration. Negative durations are recorded as zero.
+   * Must only be called from a single thread.
+   */
+  void record(std::chrono::nanoseconds duration);
+
+  LatencyStatistics getStatistics() const;
+
+  std::chrono::nanoseconds getBucketWidth() const;
+  size_t getBucketCount() const;
+
+private:
+  const int64_t bucket_width_ns_;
+  const size_t bucket_count_;
+
+  // bucket_count_ buckets followed by the overflow bucket
+  std::unique_ptr<std::atomic<uint64_t>[]> buckets_;
+  std::atomic<uint64_t> count_;
+  std::atomic<int64_t> sum_ns_;
+  std::atomic<int64_t> min_ns_;
+  std::atomic<int64_t> max_ns_;
+};
+
+/**
+ * Statistics of every phase of the ethercat loop.
+ */
+struct EthercatCycleTimings
+{
+  // Sending and receiving the process data
+  LatencyStatistics send_receive;
+  // Checking the state of the slaves and recovering them, done by the supervisor thread
+  LatencyStatistics monitor_slaves;
+  // Publishing the inputs to the control thread
+  LatencyStatistics publish;
+  // Running the cycle callback, instead of publishing the inputs
+  LatencyStatistics cycle_callback;
+  // Delay between the deadline of a cycle and the actual wake-up
+  LatencyStatistics sleep_overshoot;
+  // Duration between two consecutive wake-ups
+  LatencyStatistics period;
+};
+
+}  // namespace march
+#endif  // MARCH_HARDWARE_ETHERCAT_LATENCY_HISTOGRAM_H
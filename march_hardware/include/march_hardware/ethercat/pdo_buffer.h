@@ -0,0 +1,73 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ETHERCAT_PDO_BUFFER_H
+#define MARCH_HARDWARE_ETHERCAT_PDO_BUFFER_H
+#include "pdo_types.h"
+
+#include <cstdint>
+#include <cstring>
+
+namespace march
+{
+/**
+ * Reads and writes the PDOs of a single slave directly in its process data.
+ * EtherCAT data is little-endian, as is the host, so every access compiles
+ * to a single unaligned load or store.
+ *
+ * Has the same read and write methods as PdoSlaveInterface, so code templated
+ * on the PDO access compiles to inline memory accesses for the SOEM backend
+ * and to virtual calls for other backends, e.g. mocks in tests.
+ */
+class PdoBuffer
+{
+public:
+  PdoBuffer(const uint8_t* inputs, uint8_t* outputs) : inputs_(inputs), outputs_(outputs)
+  {
+  }
+
+  bool hasInputs() const
+  {
+    return this->inputs_ != nullptr;
+  }
+  bool hasOutputs() const
+  {
+    return this->outputs_ != nullptr;
+  }
+
+  void write8(uint8_t module_index, bit8 value)
+  {
+    this->outputs_[module_index] = value.ui;
+  }
+  void write16(uint8_t module_index, bit16 value)
+  {
+    std::memcpy(this->outputs_ + module_index, &value.ui, sizeof(value.ui));
+  }
+  void write32(uint8_t module_index, bit32 value)
+  {
+    std::memcpy(this->outputs_ + module_index, &value.ui, sizeof(value.ui));
+  }
+
+  bit8 read8(uint8_t module_index) const
+  {
+    bit8 value;
+    value.ui = this->inputs_[module_index];
+    return value;
+  }
+  bit16 read16(uint8_t module_index) const
+  {
+    bit16 value;
+    std::memcpy(&value.ui, this->inputs_ + module_index, sizeof(value.ui));
+    return value;
+  }
+  bit32 read32(uint8_t module_index) const
+  {
+    bit32 value;
+    std::memcpy(&value.ui, this->inputs_ + module_index, sizeof(value.ui));
+    return value;
+  }
+
+private:
+  const uint8_t* inputs_;
+  uint8_t* outputs_;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_ETHERCAT_PDO_BUFFER_H
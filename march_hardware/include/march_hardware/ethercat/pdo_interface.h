@@ -1,5 +1,6 @@
 #ifndef MARCH_HARDWARE_PDO_INTERFACE_H
 #define MARCH_HARDWARE_PDO_INTERFACE_H
+#include "pdo_buffer.h"
 #include "pdo_types.h"
 
 #include <cstdint>
@@ -21,6 +22,20 @@ public:
   virtual bit8 read8(uint16_t slave_index, uint8_t module_index) const = 0;
   virtual bit16 read16(uint16_t slave_index, uint8_t module_index) const = 0;
   virtual bit32 read32(uint16_t slave_index, uint8_t module_index) const = 0;
+
+  /**
+   * Returns the process data of the given slave, when the backend allows accessing it directly.
+   * The pointers can move when the process data is relocated, so they must be requested again every cycle.
+   * @return Inputs and outputs of the slave, or nullptr when only the read and write methods are supported
+   */
+  virtual const uint8_t* getInputs(uint16_t /* slave_index */) const
+  {
+    return nullptr;
+  }
+  virtual uint8_t* getOutputs(uint16_t /* slave_index */)
+  {
+    return nullptr;
+  }
 };
 
 /**
@@ -66,6 +81,16 @@ public:
     return this->pdo_->read32(this->slave_index_, module_index);
   }
 
+  /**
+   * Returns direct access to the process data of this slave for the current cycle.
+   * Check PdoBuffer::hasInputs() and PdoBuffer::hasOutputs() before using it,
+   * since not every backend supports it.
+   */
+  PdoBuffer getPdoBuffer()
+  {
+    return PdoBuffer(this->pdo_->getInputs(this->slave_index_), this->pdo_->getOutputs(this->slave_index_));
+  }
+
 private:
   const uint16_t slave_index_;
   PdoInterfacePtr pdo_;
@@ -73,8 +98,9 @@ private:
 
 /**
  * An implementation of the PdoInterface using SOEM.
+ * Gives direct access to the process data, so slaves can read and write it through a PdoBuffer.
  */
-class PdoInterfaceImpl : public PdoInterface
+class PdoInterfaceImpl final : public PdoInterface
 {
 public:
   /**
@@ -93,6 +119,9 @@ public:
   bit8 read8(uint16_t slave_index, uint8_t module_index) const override;
   bit16 read16(uint16_t slave_index, uint8_t module_index) const override;
   bit32 read32(uint16_t slave_index, uint8_t module_index) const override;
+
+  const uint8_t* getInputs(uint16_t slave_index) const override;
+  uint8_t* getOutputs(uint16_t slave_index) override;
 };
 }  // namespace march
 #endif  // MARCH_HARDWARE_PDO_INTERFACE_H
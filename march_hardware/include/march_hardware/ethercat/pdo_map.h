@@ -3,6 +3,9 @@
 #define MARCH_HARDWARE_PDOMAP_H
 #include "march_hardware/ethercat/sdo_interface.h"
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <utility>
 #include <vector>
@@ -62,6 +65,35 @@ enum class IMCObjectName
   MotorVoltage
 };
 
+/**
+ * Byte offsets of the mapped IMC objects in the process data of a slave, indexed by object name.
+ * Resolved once from the result of PDOmap::map(), so looking up an offset every cycle is a single load
+ * instead of hashing the object name.
+ */
+class IMCObjectOffsets
+{
+public:
+  IMCObjectOffsets();
+  explicit IMCObjectOffsets(const std::unordered_map<IMCObjectName, uint8_t>& byte_offsets);
+
+  /**
+   * Returns the byte offset of the given object, which is 0 when the object is not mapped.
+   */
+  uint8_t operator[](IMCObjectName object_name) const
+  {
+    return this->offsets_[static_cast<size_t>(object_name)];
+  }
+
+  bool isMapped(IMCObjectName object_name) const;
+
+  // MotorVoltage is the last IMC object name
+  static const size_t OBJECT_COUNT = static_cast<size_t>(IMCObjectName::MotorVoltage) + 1;
+
+private:
+  std::array<uint8_t, OBJECT_COUNT> offsets_;
+  std::array<bool, OBJECT_COUNT> mapped_;
+};
+
 class PDOmap
 {
 public:
@@ -87,6 +119,23 @@ private:
   std::unordered_map<IMCObjectName, uint8_t> configurePDO(SdoSlaveInterface& sdo, int base_register,
                                                           uint16_t base_sync_manager);
 
+  /** Reads the current PDO registers and sync manager assignment back from the IMC using complete access.
+   * @param registers combined addresses of the objects mapped in every used PDO register
+   * @return true when the IMC already holds the given mapping, false when it differs or could not be read */
+  bool isMapped(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers, int base_register,
+                uint16_t base_sync_manager);
+
+  /** Writes every PDO register and the sync manager assignment in a single transfer using complete access.
+   * @param registers combined addresses of the objects mapped in every used PDO register
+   * @return true when all transfers succeeded, false when the IMC rejected complete access */
+  bool writeCompleteAccess(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers,
+                           int base_register, uint16_t base_sync_manager);
+
+  /** Writes every entry of the PDO registers and the sync manager assignment in a separate transfer.
+   * @param registers combined addresses of the objects mapped in every used PDO register */
+  void writePerEntry(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers, int base_register,
+                     uint16_t base_sync_manager);
+
   std::unordered_map<IMCObjectName, IMCObject> PDO_objects;
   int total_used_bits = 0;
 
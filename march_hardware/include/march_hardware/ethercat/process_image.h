@@ -0,0 +1,124 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ETHERCAT_PROCESS_IMAGE_H
+#define MARCH_HARDWARE_ETHERCAT_PROCESS_IMAGE_H
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace march
+{
+/**
+ * Hands the process data over between the ethercat thread and the control thread without locks.
+ *
+ * The inputs and the outputs are both triple buffered. The ethercat thread publishes every
+ * complete input frame with a sequence number, and the control thread acquires a consistent
+ * copy of the latest one. In the other direction the control thread commits its outputs, of
+ * which the ethercat thread copies the latest into the io map before sending it.
+ *
+ * The input and output ranges are given as offsets in the io map, and images passed to the
+ * control thread methods use the same layout as the io map. Every group of slaves has its
+ * own input and output range.
+ */
+class ProcessImage
+{
+public:
+  struct Range
+  {
+    size_t offset;
+    size_t size;
+  };
+
+  ProcessImage() = default;
+
+  /* Delete copy and move constructor/assignment since atomics cannot be copied or moved */
+  ProcessImage(const ProcessImage&) = delete;
+  ProcessImage& operator=(const ProcessImage&) = delete;
+  ProcessImage(ProcessImage&&) = delete;
+  ProcessImage& operator=(ProcessImage&&) = delete;
+
+  /**
+   * Allocates the buffers and resets the sequence. Must only be called while neither thread uses the process image.
+   * @param outputs ranges of the outputs in the io map
+   * @param inputs ranges of the inputs in the io map
+   */
+  void configure(std::vector<Range> outputs, std::vector<Range> inputs);
+
+  /**
+   * Publishes the inputs of the io map as the latest snapshot and wakes the waiting control thread.
+   * Must only be called from the ethercat thread.
+   */
+  void publishInputs(const uint8_t* io_map);
+
+  /**
+   * Copies the latest committed outputs into the io map. Leaves the io map untouched
+   * as long as no outputs have been committed yet.
+   * Must only be called from the ethercat thread.
+   */
+  void fetchOutputs(uint8_t* io_map);
+
+  /**
+   * Commits the outputs of the given image to be sent in the next cycle.
+   * Must only be called from the control thread.
+   */
+  void commitOutputs(const uint8_t* image);
+
+  /**
+   * Copies the inputs of the latest published snapshot into the given image.
+   * Must only be called from the control thread.
+   * @returns the sequence number of the copied snapshot, 0 when nothing has been published yet
+   */
+  uint64_t acquireInputs(uint8_t* image);
+
+  /**
+   * Blocks until a snapshot newer than the given sequence number has been published.
+   * @returns true when new inputs are available, false when interrupted
+   */
+  bool waitForInputs(uint64_t sequence);
+
+  /**
+   * Wakes all threads waiting for inputs and makes subsequent waits return immediately until configured again.
+   */
+  void interrupt();
+
+  uint64_t getSequence() const;
+
+private:
+  struct InputSlot
+  {
+    std::vector<uint8_t> data;
+    uint64_t sequence = 0;
+  };
+
+  void wake();
+
+  static size_t totalSize(const std::vector<Range>& ranges);
+
+  static const uint8_t FRESH = 0x4;
+  static const uint8_t INDEX_MASK = 0x3;
+
+  std::vector<Range> outputs_;
+  std::vector<Range> inputs_;
+
+  std::array<InputSlot, 3> input_slots_;
+  // Slot index with the FRESH flag when it contains inputs not yet acquired
+  std::atomic<uint8_t> input_middle_{ 1 };
+  uint8_t input_back_ = 0;
+  uint8_t input_front_ = 2;
+
+  std::array<std::vector<uint8_t>, 3> output_slots_;
+  // Slot index with the FRESH flag when it contains outputs not yet fetched
+  std::atomic<uint8_t> output_middle_{ 1 };
+  uint8_t output_back_ = 0;
+  uint8_t output_front_ = 2;
+  bool outputs_committed_ = false;
+
+  std::atomic<uint64_t> sequence_{ 0 };
+  std::atomic<bool> interrupted_{ false };
+  // Changed on every publish and interrupt, waited on with a futex
+  std::atomic<uint32_t> futex_word_{ 0 };
+  std::atomic<uint32_t> waiters_{ 0 };
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_ETHERCAT_PROCESS_IMAGE_H
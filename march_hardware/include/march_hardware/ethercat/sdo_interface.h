@@ -1,8 +1,11 @@
 #ifndef MARCH_HARDWARE_SDO_INTERFACE_H
 #define MARCH_HARDWARE_SDO_INTERFACE_H
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 namespace march
 {
@@ -28,6 +31,30 @@ public:
     return this->write(slave, index, sub, sizeof(T), &value);
   }
 
+  /**
+   * Writes all sub indices of an array object in a single transfer using CoE complete access.
+   * Sub index 0 is set to the amount of entries and takes 16 bits, of which the upper 8 bits are padding,
+   * followed by the entries from sub index 1 onwards.
+   *
+   * @tparam T type of the entries of the object
+   * @param slave index of the slave
+   * @param index index of the register
+   * @param entries values of sub index 1 onwards
+   * @return received working counter from the write operation. Returns 0 when the slave does not support complete
+   *         access or a failure occurred, positive otherwise.
+   */
+  template <typename T>
+  int writeCompleteAccess(uint16_t slave, uint16_t index, const std::vector<T>& entries)
+  {
+    std::vector<uint8_t> data(2 + entries.size() * sizeof(T), 0);
+    data[0] = static_cast<uint8_t>(entries.size());
+    if (!entries.empty())
+    {
+      std::memcpy(&data[2], entries.data(), entries.size() * sizeof(T));
+    }
+    return this->writeCompleteAccess(slave, index, data.size(), data.data());
+  }
+
   /**
    * Reads an SDO from given location.
    *
@@ -45,10 +72,42 @@ public:
     return this->read(slave, index, sub, val_size, &value);
   }
 
+  /**
+   * Reads all sub indices of an array object in a single transfer using CoE complete access.
+   *
+   * @tparam T type of the entries of the object
+   * @param slave index of the slave
+   * @param index index of the register
+   * @param entries reference to the values of sub index 1 onwards, resized to the amount in sub index 0
+   * @return received working counter from the read operation. Returns 0 when the slave does not support complete
+   *         access or a failure occurred, positive otherwise.
+   */
+  template <typename T>
+  int readCompleteAccess(uint16_t slave, uint16_t index, std::vector<T>& entries) const
+  {
+    std::vector<uint8_t> data(2 + UINT8_MAX * sizeof(T), 0);
+    int size = data.size();
+    const int working_counter = this->readCompleteAccess(slave, index, size, data.data());
+    if (working_counter == 0 || size < 2 || static_cast<size_t>(size) < 2 + data[0] * sizeof(T))
+    {
+      return 0;
+    }
+    entries.resize(data[0]);
+    if (!entries.empty())
+    {
+      std::memcpy(entries.data(), &data[2], entries.size() * sizeof(T));
+    }
+    return working_counter;
+  }
+
 protected:
   virtual int write(uint16_t slave, uint16_t index, uint8_t sub, std::size_t size, void* value) = 0;
 
+  virtual int writeCompleteAccess(uint16_t slave, uint16_t index, std::size_t size, void* data) = 0;
+
   virtual int read(uint16_t slave, uint16_t index, uint8_t sub, int& val_size, void* value) const = 0;
+
+  virtual int readCompleteAccess(uint16_t slave, uint16_t index, int& size, void* data) const = 0;
 };
 
 /**
@@ -69,18 +128,43 @@ public:
   template <typename T>
   int write(uint16_t index, uint8_t sub, T value)
   {
+    this->transfer_count_++;
     return this->sdo_->write(this->slave_index_, index, sub, value);
   }
 
+  template <typename T>
+  int writeCompleteAccess(uint16_t index, const std::vector<T>& entries)
+  {
+    this->transfer_count_++;
+    return this->sdo_->writeCompleteAccess(this->slave_index_, index, entries);
+  }
+
   template <typename T>
   int read(uint16_t index, uint8_t sub, int& val_size, T& value) const
   {
+    this->transfer_count_++;
     return this->sdo_->read(this->slave_index_, index, sub, val_size, value);
   }
 
+  template <typename T>
+  int readCompleteAccess(uint16_t index, std::vector<T>& entries) const
+  {
+    this->transfer_count_++;
+    return this->sdo_->readCompleteAccess(this->slave_index_, index, entries);
+  }
+
+  /**
+   * Returns the amount of SDO reads and writes done through this interface.
+   */
+  size_t getTransferCount() const
+  {
+    return this->transfer_count_;
+  }
+
 private:
   const uint16_t slave_index_;
   SdoInterfacePtr sdo_;
+  mutable size_t transfer_count_ = 0;
 };
 
 /**
@@ -101,7 +185,11 @@ public:
 protected:
   int write(uint16_t slave, uint16_t index, uint8_t sub, std::size_t size, void* value) override;
 
+  int writeCompleteAccess(uint16_t slave, uint16_t index, std::size_t size, void* data) override;
+
   int read(uint16_t slave, uint16_t index, uint8_t sub, int& val_size, void* value) const override;
+
+  int readCompleteAccess(uint16_t slave, uint16_t index, int& size, void* data) const override;
 };
 }  // namespace march
 #endif  // MARCH_HARDWARE_SDO_INTERFACE_H
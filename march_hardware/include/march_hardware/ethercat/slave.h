@@ -39,13 +39,24 @@ public:
   bool initSdo(int cycle_time)
   {
     SdoSlaveInterface sdo_slave_interface(this->slave_index_, this->sdo_interface_);
-    return this->initSdo(sdo_slave_interface, cycle_time);
+    const bool reset = this->initSdo(sdo_slave_interface, cycle_time);
+    this->sdo_transfer_count_ += sdo_slave_interface.getTransferCount();
+    return reset;
   }
 
   void reset()
   {
     SdoSlaveInterface sdo_slave_interface(this->slave_index_, this->sdo_interface_);
     this->reset(sdo_slave_interface);
+    this->sdo_transfer_count_ += sdo_slave_interface.getTransferCount();
+  }
+
+  /**
+   * Returns the amount of SDO transfers done by initSdo() and reset() since construction.
+   */
+  size_t getSdoTransferCount() const
+  {
+    return this->sdo_transfer_count_;
   }
 
 protected:
@@ -61,6 +72,7 @@ protected:
 private:
   const uint16_t slave_index_;
   SdoInterfacePtr sdo_interface_;
+  size_t sdo_transfer_count_ = 0;
 };
 }  // namespace march
 
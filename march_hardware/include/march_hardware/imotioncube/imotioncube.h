@@ -7,13 +7,16 @@
 #include "march_hardware/ethercat/pdo_types.h"
 #include "march_hardware/ethercat/sdo_interface.h"
 #include "march_hardware/ethercat/slave.h"
+#include "imotioncube_inputs.h"
+#include "imotioncube_outputs.h"
 #include "imotioncube_state.h"
 #include "imotioncube_target_state.h"
+#include "setup_image.h"
 #include "march_hardware/encoder/absolute_encoder.h"
 #include "march_hardware/encoder/incremental_encoder.h"
+#include "march_hardware/robot_state.h"
 
 #include <memory>
-#include <unordered_map>
 #include <string>
 
 namespace march
@@ -32,8 +35,13 @@ public:
    */
   IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> absolute_encoder,
               std::unique_ptr<IncrementalEncoder> incremental_encoder, ActuationMode actuation_mode);
+  /**
+   * Constructs an IMotionCube with an incremental and absolute encoder and the setup of its .sw file.
+   *
+   * @param setup setup that is downloaded to the drive when it differs, required before initializing
+   */
   IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> absolute_encoder,
-              std::unique_ptr<IncrementalEncoder> incremental_encoder, std::string& sw_stream,
+              std::unique_ptr<IncrementalEncoder> incremental_encoder, SetupImagePtr setup,
               ActuationMode actuation_mode);
 
   ~IMotionCube() noexcept override = default;
@@ -42,6 +50,20 @@ public:
   IMotionCube(const IMotionCube&) = delete;
   IMotionCube& operator=(const IMotionCube&) = delete;
 
+  /**
+   * Decodes the input PDO into the inputs served by the getters. Must be called once per cycle, after the
+   * process data is received and before any of the getters is used.
+   */
+  virtual void readInputs();
+  const IMotionCubeInputs& getInputs() const;
+
+  /**
+   * Writes the outputs staged by setControlWord() and the actuate methods to the output PDO at once.
+   * Must be called once per cycle, before the process data is sent.
+   */
+  virtual void writeOutputs();
+  const IMotionCubeOutputs& getOutputs() const;
+
   virtual double getAngleRadAbsolute();
   virtual double getAngleRadIncremental();
   double getAbsoluteRadPerBit() const;
@@ -67,11 +89,29 @@ public:
 
   void setControlWord(uint16_t control_word);
 
+  /**
+   * Sets the conversions of the inputs of this drive to SI units for the given joint of the robot state.
+   */
+  void configureState(RobotState& state, size_t joint) const;
+
+  /**
+   * Stores the inputs decoded by the last readInputs() for the given joint of the robot state.
+   */
+  void storeState(RobotState& state, size_t joint) const;
+
   virtual void actuateRad(double target_rad);
   virtual void actuateTorque(int16_t target_torque);
 
-  void goToTargetState(IMotionCubeTargetState target_state);
-  virtual void goToOperationEnabled();
+  /**
+   * Advances the drive by at most one transition towards operation enabled, based on the status word of the last
+   * readInputs(). Must be called once per EtherCAT cycle until it returns true, so the control word of every step
+   * is sent to the drive before the next step is taken. This allows enabling several drives at the same time.
+   * @return true when the drive reached operation enabled
+   * @throws HardwareException When the actuation mode is unknown, the encoder has reset or the joint is outside its
+   * hard limits
+   * @throws std::domain_error When the drive went to fault state while being enabled
+   */
+  virtual bool stepToOperationEnabled();
 
   /** @brief Override comparison operator */
   friend bool operator==(const IMotionCube& lhs, const IMotionCube& rhs)
@@ -88,14 +128,30 @@ public:
   }
 
   constexpr static double MAX_TARGET_DIFFERENCE = 0.393;
+  // Peak current of the drive in A
+  constexpr static float PEAK_CURRENT = 40.0;
+  // Maximum measurable DC voltage in V, found in EMS Setup/Drive info button
+  constexpr static float V_DC_MAX_MEASURABLE = 102.3;
+  // Conversion parameter of currents and voltages, see Technosoft CoE programming manual (2015 page 89)
+  constexpr static float IU_CONVERSION_CONST = 65520.0;
   // This value is slightly larger than the current limit of the
   // linear joints defined in the URDF.
   const static int16_t MAX_TARGET_TORQUE = 23500;
 
   // Watchdog base time = 1 / 25 MHz * (2498 + 2) = 0.0001 seconds=100 µs
   static const uint16_t WATCHDOG_DIVIDER = 2498;
-  // 500 * 100us = 50 ms = watchdog timer
-  static const uint16_t WATCHDOG_TIME = 500;
+  // 10 * 100us = 1 ms = smallest watchdog timer
+  static const uint16_t WATCHDOG_MIN_TIME = 10;
+
+  /**
+   * Returns the watchdog time in units of the watchdog base time (100 µs) for the given cycle time.
+   * The watchdog expires after 12.5 missed cycles, which is 50 ms for a cycle time of 4 ms.
+   * @param cycle_time_us the cycle time of the EtherCAT in microseconds
+   */
+  static uint16_t getWatchdogTime(int cycle_time_us);
+
+  // Percentage of the setup after which the download progress is reported
+  static const int SETUP_PROGRESS_STEP = 10;
 
 protected:
   bool initSdo(SdoSlaveInterface& sdo, int cycle_time) override;
@@ -105,29 +161,42 @@ protected:
 private:
   void actuateIU(int32_t target_iu);
 
+  /**
+   * Sets the current position or zero torque as target, so the joint holds still when operation is enabled.
+   * @throws HardwareException When the encoder has reset or the joint is outside its hard limits
+   */
+  void actuateCurrentPosition();
+
+  /**
+   * Logs the error registers of the drive after it went to fault state.
+   */
+  void logFault(const IMotionCubeTargetState& target_state);
+
+  /**
+   * Decodes and encodes the PDOs through either the PdoSlaveInterface of this slave or a PdoBuffer, so the SOEM
+   * backend reads and writes the process data with inline loads and stores instead of a virtual call per object.
+   */
+  template <typename Pdo>
+  void decodeInputs(const Pdo& pdo);
+  template <typename Pdo>
+  void encodeOutputs(Pdo& pdo) const;
+
   void mapMisoPDOs(SdoSlaveInterface& sdo);
   void mapMosiPDOs(SdoSlaveInterface& sdo);
   /**
    * Initializes all iMC by checking the setup on the drive and writing necessary SDO registers.
    * @param sdo SDO interface to write to
-   * @param cycle_time the cycle time of the EtherCAT
+   * @param cycle_time the cycle time of the EtherCAT in microseconds
    * @return 1 if reset is necessary, otherwise it returns 0
    */
   bool writeInitialSettings(SdoSlaveInterface& sdo, int cycle_time);
-  /**
-   * Calculates checksum on .sw file passed in string format in sw_string_ by simple summation until next empty line.
-   * Start_address and end_address are filled in the method and used for downloading the .sw file to the drive.
-   * @param start_address the found start address of the setup in the .sw file
-   * @param end_address the found end address of the setup in the .sw file
-   * @return the computed checksum in the .sw file
-   */
-  uint16_t computeSWCheckSum(uint16_t& start_address, uint16_t& end_address);
   /**
    * Compares the checksum of the .sw file and the setup on the drive. If both are equal 1 is returned.
-   * This method makes use of the computeSWCheckSum(int&, int&) method. The start and end addresses are used in
-   * conjunction with the registers 0x2069 and 0x206A (described in the CoE manual fro Technosoft(2019) in par. 16.2.5
-   * and 16.2.6) to determine the checksum on the drive.
+   * The start and end addresses of the setup are used in conjunction with the registers 0x2069 and 0x206A
+   * (described in the CoE manual fro Technosoft(2019) in par. 16.2.5 and 16.2.6) to determine the checksum on the
+   * drive.
    * @return true or 1 if the setup is verified and therefore correct, otherwise returns 0
+   * @throws HardwareException When no setup was given
    */
   bool verifySetup(SdoSlaveInterface& sdo);
   /**
@@ -142,11 +211,15 @@ private:
   // do not need to be passed around.
   std::unique_ptr<AbsoluteEncoder> absolute_encoder_;
   std::unique_ptr<IncrementalEncoder> incremental_encoder_;
-  std::string sw_string_;
+  SetupImagePtr setup_;
   ActuationMode actuation_mode_;
+  // Index in the CiA402 transitions towards operation enabled
+  size_t enable_step_ = 0;
+  IMotionCubeInputs inputs_;
+  IMotionCubeOutputs outputs_;
 
-  std::unordered_map<IMCObjectName, uint8_t> miso_byte_offsets_;
-  std::unordered_map<IMCObjectName, uint8_t> mosi_byte_offsets_;
+  IMCObjectOffsets miso_byte_offsets_;
+  IMCObjectOffsets mosi_byte_offsets_;
 };
 
 }  // namespace march
@@ -0,0 +1,29 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_IMOTIONCUBE_INPUTS_H
+#define MARCH_HARDWARE_IMOTIONCUBE_INPUTS_H
+#include <cstdint>
+
+namespace march
+{
+/**
+ * The input PDO of an IMotionCube, decoded once per cycle so all readers see the values of the same cycle.
+ * The values are in the units of the drive, see the Technosoft CoE programming manual.
+ */
+struct IMotionCubeInputs
+{
+  uint16_t status_word = 0;
+  uint16_t motion_error = 0;
+  uint16_t detailed_error = 0;
+  uint16_t second_detailed_error = 0;
+  // Position and velocity of the absolute encoder, the velocity is a fixed point 16.16 number
+  int32_t absolute_position = 0;
+  int32_t absolute_velocity = 0;
+  // Position and velocity of the incremental encoder on the motor, the velocity is a fixed point 16.16 number
+  int32_t incremental_position = 0;
+  int32_t incremental_velocity = 0;
+  int16_t torque = 0;
+  uint16_t dc_link_voltage = 0;
+  uint16_t motor_voltage = 0;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_IMOTIONCUBE_INPUTS_H
@@ -0,0 +1,19 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_IMOTIONCUBE_OUTPUTS_H
+#define MARCH_HARDWARE_IMOTIONCUBE_OUTPUTS_H
+#include <cstdint>
+
+namespace march
+{
+/**
+ * The output PDO of an IMotionCube, staged by the control thread and written to the process data at once
+ * every cycle, so the drive never receives a partially updated set of outputs.
+ */
+struct IMotionCubeOutputs
+{
+  uint16_t control_word = 0;
+  int32_t target_position = 0;
+  int16_t target_torque = 0;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_IMOTIONCUBE_OUTPUTS_H
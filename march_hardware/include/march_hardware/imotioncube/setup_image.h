@@ -0,0 +1,54 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_IMOTIONCUBE_SETUP_IMAGE_H
+#define MARCH_HARDWARE_IMOTIONCUBE_SETUP_IMAGE_H
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <vector>
+
+namespace march
+{
+/**
+ * Setup of an IMotionCube parsed from a .sw file, which is downloaded to the drive when
+ * its checksum differs from the setup on the drive.
+ *
+ * A .sw file starts with the start address in hexadecimal on the first line, followed by
+ * one 16 bit word in hexadecimal per line. The setup ends at the first empty line.
+ */
+class SetupImage
+{
+public:
+  SetupImage(uint16_t start_address, std::vector<uint16_t> words);
+
+  /**
+   * Parses the setup from the given .sw contents, directly from the stream buffer.
+   * @throws HardwareException When the contents are not a valid setup
+   */
+  static SetupImage parse(std::istream& sw);
+
+  uint16_t getStartAddress() const;
+
+  /**
+   * Returns the end address of the checksum range on the drive, which is the start address plus the amount of words.
+   */
+  uint16_t getEndAddress() const;
+
+  /**
+   * Returns the sum of all words, as computed by the drive over the checksum range.
+   */
+  uint16_t getChecksum() const;
+
+  const std::vector<uint16_t>& getWords() const;
+
+private:
+  uint16_t start_address_;
+  std::vector<uint16_t> words_;
+  uint16_t checksum_ = 0;
+};
+
+/**
+ * Shared pointer to a SetupImage, shared between the IMotionCubes that use the same .sw file.
+ */
+using SetupImagePtr = std::shared_ptr<const SetupImage>;
+}  // namespace march
+#endif  // MARCH_HARDWARE_IMOTIONCUBE_SETUP_IMAGE_H
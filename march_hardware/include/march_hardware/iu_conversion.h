@@ -0,0 +1,21 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_IU_CONVERSION_H
+#define MARCH_HARDWARE_IU_CONVERSION_H
+#include <cstddef>
+#include <cstdint>
+
+namespace march
+{
+/**
+ * Converts a column of values in Internal Units (IU) to SI units with the affine transform
+ * si[i] = (iu[i] - offset[i]) * scale[i], which gives the same results as Encoder::toRad().
+ * Converts four values at a time with AVX or two at a time with SSE2 when available.
+ * @param iu values in IU
+ * @param offset value in IU that corresponds to zero in SI units, per value
+ * @param scale SI units per IU, per value
+ * @param si output, may not overlap with the inputs
+ * @param count amount of values in every column
+ */
+void convertIU(const int32_t* iu, const double* offset, const double* scale, double* si, size_t count);
+}  // namespace march
+#endif  // MARCH_HARDWARE_IU_CONVERSION_H
@@ -9,6 +9,7 @@
 
 #include <march_hardware/imotioncube/imotioncube.h>
 #include <march_hardware/power/power_distribution_board.h>
+#include <march_hardware/robot_state.h>
 #include <march_hardware/temperature/temperature_ges.h>
 #include <march_hardware/imotioncube/imotioncube_state.h>
 
@@ -47,17 +48,54 @@ public:
   Joint& operator=(Joint&&) = delete;
 
   bool initialize(int cycle_time);
-  void prepareActuation();
+
+  /**
+   * Advances the iMotionCube by at most one transition towards operation enabled, see
+   * IMotionCube::stepToOperationEnabled(). Once enabled, the positions of this joint in its robot state are
+   * initialized from the last inputs, see RobotState::initializePosition().
+   * @return true when the joint is prepared for actuation
+   * @throws HardwareException When the joint is not allowed to actuate
+   */
+  bool stepPrepareActuation();
+
+  /**
+   * Decodes the inputs of the iMotionCube received in this cycle, see IMotionCube::readInputs().
+   * Stale inputs are not decoded, since they did not change since the previous cycle.
+   * @param fresh Whether the EtherCAT master received new inputs from the slaves since the previous call
+   */
+  void readInputs(bool fresh);
+
+  /**
+   * Writes the staged outputs of the iMotionCube for this cycle, see IMotionCube::writeOutputs().
+   */
+  void writeOutputs();
+
+  /**
+   * Sets the conversions of the inputs of this joint for the given joint index of the robot state.
+   * The position and velocity getters of this joint then read that entry of the state, so the state
+   * must outlive this joint.
+   */
+  void configureState(RobotState& state, size_t index);
+
+  /**
+   * Stores the inputs of this joint decoded by the last readInputs() and the temperature of its
+   * temperature slave for the given joint index of the robot state.
+   */
+  void storeState(RobotState& state, size_t index) const;
 
   void actuateRad(double target_position);
   void actuateTorque(int16_t target_torque);
-  void readEncoders(const ros::Duration& elapsed_time);
 
+  /**
+   * Positions and velocity of this joint in the robot state set by configureState(), as of the last
+   * RobotState::update(). Zero when this joint has no robot state.
+   */
   double getPosition() const;
   double getVelocity() const;
-  double getVoltageVelocity() const;
   double getIncrementalPosition() const;
   double getAbsolutePosition() const;
+
+  double getVoltageVelocity() const;
   int16_t getTorque();
   int32_t getAngleIUAbsolute();
   int32_t getAngleIUIncremental();
@@ -71,12 +109,16 @@ public:
   int getIMotionCubeSlaveIndex() const;
   int getNetNumber() const;
 
+  /**
+   * Returns the amount of SDO transfers done with the slaves of this joint.
+   */
+  size_t getSdoTransferCount() const;
+
   ActuationMode getActuationMode() const;
 
   bool hasIMotionCube() const;
   bool hasTemperatureGES() const;
   bool canActuate() const;
-  bool receivedDataUpdate();
   void setAllowActuation(bool allow_actuation);
 
   /** @brief Override comparison operator */
@@ -123,24 +165,28 @@ public:
   }
 
 private:
+  /**
+   * Stores the last inputs of this joint in its robot state and initializes its positions from them.
+   */
+  void initializeStatePosition();
+
+  /**
+   * Returns whether the incremental encoder of the given iMotionCube has a higher resolution than its absolute
+   * encoder, in which case it supplies the position and velocity of the joint.
+   */
+  static bool usesIncrementalEncoder(const IMotionCube* imc);
+
   const std::string name_;
   const int net_number_;
   bool allow_actuation_ = false;
-  float previous_imc_volt_ = 0.0;
-  float previous_motor_current_ = 0.0;
-  float previous_motor_volt_ = 0.0;
-  double previous_absolute_position_ = 0.0;
-  double previous_incremental_position_ = 0.0;
-  double previous_absolute_velocity_ = 0.0;
-  double previous_incremental_velocity_ = 0.0;
-
-  double position_ = 0.0;
-  double incremental_position_ = 0.0;
-  double absolute_position_ = 0.0;
-  double velocity_ = 0.0;
 
   std::unique_ptr<IMotionCube> imc_ = nullptr;
   std::unique_ptr<TemperatureGES> temperature_ges_ = nullptr;
+  // Chosen once at construction, since the resolutions of the encoders never change
+  bool use_incremental_encoder_ = false;
+
+  RobotState* state_ = nullptr;
+  size_t state_index_ = 0;
 };
 
 }  // namespace march
@@ -5,6 +5,9 @@
 #include "march_hardware/ethercat/ethercat_master.h"
 #include "march_hardware/joint.h"
 #include "march_hardware/power/power_distribution_board.h"
+#include "march_hardware/realtime_config.h"
+#include "march_hardware/robot_state.h"
+#include "march_hardware/startup_timeline.h"
 
 #include <cstdint>
 #include <memory>
@@ -22,16 +25,31 @@ private:
   urdf::Model urdf_;
   EthercatMaster ethercatMaster;
   std::unique_ptr<PowerDistributionBoard> pdb_;
+  RealtimeConfig controller_realtime_config_;
+  RobotState robot_state_;
+
+  void configureRobotState();
+
+  /**
+   * Decodes the inputs of all joints received in this cycle and converts them in the robot state.
+   * @param fresh Whether the EtherCAT master received new inputs since the previous call
+   */
+  void readInputs(bool fresh);
+
+  /**
+   * Writes the staged outputs of all joints to the process data.
+   */
+  void writeOutputs();
 
 public:
   using iterator = std::vector<Joint>::iterator;
 
-  MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf, ::std::string ifName, int ecatCycleTime,
-             int ecatSlaveTimeout);
+  MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf, ::std::string ifName, int ecatCycleTimeUs,
+             int ecatSlaveTimeout, int ecatSpinTime = 0, int ecatSlowGroupDivider = 1);
 
   MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf,
-             std::unique_ptr<PowerDistributionBoard> powerDistributionBoard, ::std::string ifName, int ecatCycleTime,
-             int ecatSlaveTimeout);
+             std::unique_ptr<PowerDistributionBoard> powerDistributionBoard, ::std::string ifName, int ecatCycleTimeUs,
+             int ecatSlaveTimeout, int ecatSpinTime = 0, int ecatSlowGroupDivider = 1);
 
   ~MarchRobot();
 
@@ -45,6 +63,15 @@ public:
 
   void resetIMotionCubes();
 
+  /**
+   * Prepares all joints that are allowed to actuate at the same time. Every EtherCAT cycle each drive is advanced
+   * by one transition towards operation enabled, see Joint::stepPrepareActuation(). When the EtherCAT loop stops
+   * in the meantime, the exception that stopped it is rethrown, see EthercatMaster::getLastException().
+   * @throws HardwareException When not all joints are prepared within PREPARE_ACTUATION_TIMEOUT_MS, or when the
+   *                           EtherCAT loop stopped without an exception
+   */
+  void prepareActuation();
+
   void startEtherCAT(bool reset_imc);
 
   void stopEtherCAT();
@@ -57,10 +84,46 @@ public:
 
   std::exception_ptr getLastEthercatException() const noexcept;
 
+  /**
+   * Writes the staged outputs of all joints and waits for the next PDO, see EthercatMaster::waitForPdo().
+   * Then decodes the inputs of all joints.
+   */
   void waitForPdo();
 
+  /**
+   * Runs the given callback in the ethercat loop, see EthercatMaster::setCycleCallback(). The inputs of all joints
+   * are decoded before every call and their staged outputs are written after every call.
+   */
+  void setEthercatCycleCallback(EthercatMaster::CycleCallback callback);
+
+  /**
+   * Updates the positions and velocities of all joints in the robot state with the inputs read since the previous
+   * update, see RobotState::update().
+   * @param elapsed_seconds Time since the previous update, used to extrapolate when no new inputs were read
+   */
+  const RobotState& updateRobotState(double elapsed_seconds);
+  const RobotState& getRobotState() const;
+
   int getEthercatCycleTime() const;
 
+  void setEthercatRealtimeConfig(RealtimeConfig config);
+
+  /**
+   * Real-time settings for the thread running the controllers when they are not run in the ethercat loop.
+   * They are not applied by the robot, but by the thread running the controllers.
+   */
+  void setControllerRealtimeConfig(RealtimeConfig config);
+  const RealtimeConfig& getControllerRealtimeConfig() const;
+
+  EthercatCycleTimings getEthercatCycleTimings() const;
+
+  EthercatDiagnostics getEthercatDiagnostics() const;
+
+  /**
+   * Returns the timeline of the last start of EtherCAT, to which later start-up phases can be added.
+   */
+  StartupTimeline& getStartupTimeline();
+
   Joint& getJoint(::std::string jointName);
 
   Joint& getJoint(size_t index);
@@ -75,6 +138,8 @@ public:
 
   const urdf::Model& getUrdf() const;
 
+  static const int PREPARE_ACTUATION_TIMEOUT_MS = 5000;
+
   /** @brief Override comparison operator */
   friend bool operator==(const MarchRobot& lhs, const MarchRobot& rhs)
   {
@@ -0,0 +1,48 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_REALTIME_CONFIG_H
+#define MARCH_HARDWARE_REALTIME_CONFIG_H
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+namespace march
+{
+/**
+ * Real-time settings of a thread, applied by the thread itself before it starts its loop.
+ */
+struct RealtimeConfig
+{
+  // SCHED_FIFO priority between 1 and 99, 0 keeps the default scheduling
+  int priority = 0;
+  // CPUs the thread is pinned to, empty keeps the inherited affinity
+  std::vector<int> cpus;
+  // Locks all current and future memory of the process, so it is never paged out
+  bool lock_memory = false;
+  // Amount of bytes of the stack touched in advance, so growing the stack never page faults
+  size_t prefault_stack_size = 0;
+};
+
+/**
+ * Real-time settings actually granted by the system, which can be less than configured
+ * due to missing privileges, e.g. RLIMIT_RTPRIO or RLIMIT_MEMLOCK.
+ */
+struct RealtimeReport
+{
+  // SCHED_FIFO priority of the thread, 0 when it is not scheduled with SCHED_FIFO
+  int priority = 0;
+  // CPUs the thread is allowed to run on
+  std::vector<int> cpus;
+  bool memory_locked = false;
+  size_t prefaulted_stack_size = 0;
+};
+
+/**
+ * Applies the given config to the calling thread and reads back what was granted.
+ * Settings that could not be applied are logged as warnings instead of failing.
+ * The prefaulted stack size is limited to the stack size of the thread.
+ */
+RealtimeReport applyRealtimeConfig(const RealtimeConfig& config);
+
+std::ostream& operator<<(std::ostream& os, const RealtimeReport& report);
+}  // namespace march
+#endif  // MARCH_HARDWARE_REALTIME_CONFIG_H
@@ -0,0 +1,160 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_ROBOT_STATE_H
+#define MARCH_HARDWARE_ROBOT_STATE_H
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace march
+{
+/**
+ * State of all joints of the robot as a structure of arrays, with one entry per joint in every array.
+ * Owned by MarchRobot and filled once per cycle, so the hardware interface and controllers read
+ * contiguous arrays instead of going through the slaves of every joint. The getters of Joint are views
+ * on the entry of that joint.
+ *
+ * The inputs of the drives are stored once per cycle in Internal Units (IU) and converted to SI units
+ * with one pass per quantity over all joints, see convertIU(). The positions and velocities of the
+ * joints are then taken from the encoder with the highest resolution.
+ */
+class RobotState
+{
+public:
+  /**
+   * Inputs of a drive that are converted from IU to SI units.
+   */
+  enum class Quantity
+  {
+    AbsolutePosition,
+    IncrementalPosition,
+    AbsoluteVelocity,
+    IncrementalVelocity,
+    MotorCurrent,
+    IMCVoltage,
+    MotorVoltage,
+    Effort,
+  };
+
+  static const size_t QUANTITY_COUNT = static_cast<size_t>(Quantity::Effort) + 1;
+
+  /**
+   * Registers of a drive that are stored as they are read.
+   */
+  enum class Register
+  {
+    StatusWord,
+    MotionError,
+    DetailedError,
+    SecondDetailedError,
+  };
+
+  static const size_t REGISTER_COUNT = static_cast<size_t>(Register::SecondDetailedError) + 1;
+
+  explicit RobotState(size_t joint_count = 0);
+
+  size_t size() const;
+
+  /**
+   * Sets the conversion of a quantity of a joint, see convertIU(). Quantities without a conversion stay zero.
+   */
+  void setConversion(Quantity quantity, size_t joint, double scale, double offset_iu = 0.0);
+
+  /**
+   * Sets whether the incremental encoder supplies the position and velocity of a joint, instead of the absolute
+   * encoder.
+   */
+  void setUsesIncrementalEncoder(size_t joint, bool uses_incremental_encoder);
+
+  /**
+   * Stores a new input of a joint in IU, which is converted by the next call to convert().
+   */
+  void setIU(Quantity quantity, size_t joint, int32_t iu)
+  {
+    this->iu_[static_cast<size_t>(quantity)][joint] = iu;
+  }
+
+  /**
+   * Stores a register of a joint as it was read from the drive.
+   */
+  void setRegister(Register reg, size_t joint, uint16_t value)
+  {
+    this->registers_[static_cast<size_t>(reg)][joint] = value;
+  }
+
+  /**
+   * Stores the temperature of a joint in degrees Celsius.
+   */
+  void setTemperature(size_t joint, double temperature)
+  {
+    this->temperature_[joint] = temperature;
+  }
+
+  /**
+   * Converts the stored inputs of all joints to SI units.
+   */
+  void convert();
+
+  /**
+   * Sets the positions of all joints to the converted absolute positions and their velocities to zero.
+   * Must be called once the drives are enabled.
+   */
+  void initializePositions();
+
+  /**
+   * Converts the stored position inputs of one joint and initializes its positions like initializePositions(),
+   * for a joint that is prepared for actuation on its own.
+   */
+  void initializePosition(size_t joint);
+
+  /**
+   * Updates the positions and velocities of all joints with the inputs converted since the previous update.
+   * When no inputs were converted since then, the positions are extrapolated with the last velocities.
+   */
+  void update(double elapsed_seconds);
+
+  const std::vector<double>& get(Quantity quantity) const
+  {
+    return this->si_[static_cast<size_t>(quantity)];
+  }
+  const std::vector<uint16_t>& get(Register reg) const
+  {
+    return this->registers_[static_cast<size_t>(reg)];
+  }
+  const std::vector<double>& getTemperatures() const
+  {
+    return this->temperature_;
+  }
+  const std::vector<double>& getPositions() const
+  {
+    return this->position_;
+  }
+  const std::vector<double>& getVelocities() const
+  {
+    return this->velocity_;
+  }
+  const std::vector<double>& getIncrementalPositions() const
+  {
+    return this->incremental_position_;
+  }
+
+private:
+  using IUColumns = std::array<std::vector<int32_t>, QUANTITY_COUNT>;
+  using SIColumns = std::array<std::vector<double>, QUANTITY_COUNT>;
+
+  IUColumns iu_;
+  SIColumns offset_iu_;
+  SIColumns scale_;
+  SIColumns si_;
+  std::array<std::vector<uint16_t>, REGISTER_COUNT> registers_;
+  std::vector<double> temperature_;
+
+  std::vector<bool> uses_incremental_encoder_;
+  std::vector<double> position_;
+  std::vector<double> velocity_;
+  // Incremental position at the last update, to which the next incremental position is compared
+  std::vector<double> incremental_position_;
+  bool converted_ = false;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_ROBOT_STATE_H
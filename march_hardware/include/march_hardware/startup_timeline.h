@@ -0,0 +1,68 @@
+// Copyright 2020 Project March.
+#ifndef MARCH_HARDWARE_STARTUP_TIMELINE_H
+#define MARCH_HARDWARE_STARTUP_TIMELINE_H
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace march
+{
+/**
+ * A phase of the start-up of the whole robot or of a single slave.
+ */
+struct StartupPhase
+{
+  std::string name;
+  // Slave the phase belongs to, 0 for phases of the whole robot
+  int slave = 0;
+  // Start of the phase relative to the start of the timeline
+  std::chrono::nanoseconds start{ 0 };
+  std::chrono::nanoseconds duration{ 0 };
+  // Amount of SDO transfers done in the phase
+  size_t sdo_transfers = 0;
+};
+
+/**
+ * Records the phases of the hardware start-up, so it is visible where the start-up time goes.
+ * Phases can be recorded and read from different threads.
+ */
+class StartupTimeline
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  StartupTimeline();
+
+  /**
+   * Removes all phases and starts the timeline at the current time.
+   */
+  void clear();
+
+  /**
+   * Records a phase that started at the given time and ended now.
+   * @param slave slave the phase belongs to, 0 for phases of the whole robot
+   */
+  void record(const std::string& name, Clock::time_point start_time, int slave = 0, size_t sdo_transfers = 0);
+
+  /**
+   * Returns the recorded phases ordered by their start.
+   */
+  std::vector<StartupPhase> getPhases() const;
+
+  /**
+   * Writes the phases as CSV, with a header and the times in microseconds.
+   */
+  void writeCsv(std::ostream& os) const;
+
+  friend std::ostream& operator<<(std::ostream& os, const StartupTimeline& timeline);
+
+private:
+  mutable std::mutex mutex_;
+  Clock::time_point start_time_;
+  std::vector<StartupPhase> phases_;
+};
+}  // namespace march
+#endif  // MARCH_HARDWARE_STARTUP_TIMELINE_H
@@ -9,7 +9,7 @@ namespace march
 AbsoluteEncoder::AbsoluteEncoder(size_t number_of_bits, int32_t lower_limit_iu, int32_t upper_limit_iu,
                                  double lower_limit_rad, double upper_limit_rad, double lower_soft_limit_rad,
                                  double upper_soft_limit_rad)
-  : Encoder(number_of_bits), lower_limit_iu_(lower_limit_iu), upper_limit_iu_(upper_limit_iu)
+  : Encoder(number_of_bits, 1.0), lower_limit_iu_(lower_limit_iu), upper_limit_iu_(upper_limit_iu)
 {
   this->zero_position_iu_ = this->lower_limit_iu_ - lower_limit_rad * this->getTotalPositions() / PI_2;
   this->lower_soft_limit_iu_ = this->fromRad(lower_soft_limit_rad);
@@ -37,16 +37,6 @@ AbsoluteEncoder::AbsoluteEncoder(size_t number_of_bits, int32_t lower_limit_iu,
   }
 }
 
-double AbsoluteEncoder::toRad(int32_t iu) const
-{
-  return (iu - this->zero_position_iu_) * this->getRadPerBit();
-}
-
-double AbsoluteEncoder::getRadPerBit() const
-{
-  return PI_2 / this->getTotalPositions();
-}
-
 int32_t AbsoluteEncoder::fromRad(double rad) const
 {
   return (rad * this->getTotalPositions() / PI_2) + this->zero_position_iu_;
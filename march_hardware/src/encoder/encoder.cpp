@@ -5,7 +5,10 @@
 
 namespace march
 {
-Encoder::Encoder(size_t number_of_bits) : total_positions_(Encoder::calculateTotalPositions(number_of_bits))
+Encoder::Encoder(size_t number_of_bits, double transmission)
+  : total_positions_(Encoder::calculateTotalPositions(number_of_bits))
+  , rad_per_bit_(PI_2 / (this->total_positions_ * transmission))
+  , rad_per_second_per_velocity_(this->rad_per_bit_ / (TIME_PER_VELOCITY_SAMPLE * FIXED_POINT_TO_FLOAT_CONVERSION))
 {
 }
 
@@ -23,12 +26,17 @@ double Encoder::getAngleRad(const PdoSlaveInterface& pdo, uint8_t byte_offset) c
 double Encoder::getVelocityIU(const PdoSlaveInterface& pdo, uint8_t byte_offset) const
 {
   bit32 return_byte = pdo.read32(byte_offset);
-  return return_byte.i / (TIME_PER_VELOCITY_SAMPLE * FIXED_POINT_TO_FLOAT_CONVERSION);
+  return Encoder::toVelocityIU(return_byte.i);
+}
+
+double Encoder::toVelocityIU(int32_t velocity)
+{
+  return velocity / (TIME_PER_VELOCITY_SAMPLE * FIXED_POINT_TO_FLOAT_CONVERSION);
 }
 
 double Encoder::getVelocityRad(const PdoSlaveInterface& pdo, uint8_t byte_offset) const
 {
-  return this->getVelocityIU(pdo, byte_offset) * this->getRadPerBit();
+  return this->toVelocityRad(pdo.read32(byte_offset).i);
 }
 
 size_t Encoder::getTotalPositions() const
@@ -4,20 +4,10 @@
 namespace march
 {
 IncrementalEncoder::IncrementalEncoder(size_t number_of_bits, double transmission)
-  : Encoder(number_of_bits), transmission_(transmission)
+  : Encoder(number_of_bits, transmission), transmission_(transmission)
 {
 }
 
-double IncrementalEncoder::toRad(int32_t iu) const
-{
-  return iu * this->getRadPerBit();
-}
-
-double IncrementalEncoder::getRadPerBit() const
-{
-  return PI_2 / (this->getTotalPositions() * this->transmission_);
-}
-
 double IncrementalEncoder::getTransmission() const
 {
   return this->transmission_;
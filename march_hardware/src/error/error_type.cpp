@@ -53,6 +53,16 @@ const char* getErrorDescription(ErrorType type)
       return "Slave has incorrect SW file";
     case ErrorType::SLAVE_LOST_TIMOUT:
       return "EtherCAT slave monitor timer elapsed, connection has been lost";
+    case ErrorType::IO_MAP_OVERFLOW:
+      return "Process data of the EtherCAT slaves does not fit in the IO map";
+    case ErrorType::PREPARE_ACTUATION_TIMEOUT:
+      return "Not all joints reached operation enabled in time";
+    case ErrorType::SLAVE_RESET_FAILED:
+      return "EtherCAT slave did not return after a reset";
+    case ErrorType::ETHERCAT_LOOP_STOPPED:
+      return "EtherCAT loop stopped";
+    case ErrorType::INVALID_ETHERCAT_CONFIGURATION:
+      return "Invalid EtherCAT master configuration";
     default:
       return "Unknown error occurred. Please create/use a documented error";
   }
@@ -2,10 +2,17 @@
 #include "march_hardware/ethercat/ethercat_master.h"
 #include "march_hardware/error/hardware_exception.h"
 
+#include <algorithm>
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <ctime>
 #include <exception>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <pthread.h>
@@ -14,13 +21,98 @@
 
 namespace march
 {
-EthercatMaster::EthercatMaster(std::string ifname, int max_slave_index, int cycle_time, int slave_timeout)
+namespace
+{
+std::chrono::nanoseconds monotonicNow()
+{
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return std::chrono::seconds(now.tv_sec) + std::chrono::nanoseconds(now.tv_nsec);
+}
+
+timespec toTimespec(std::chrono::nanoseconds time)
+{
+  const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(time);
+  timespec result;
+  result.tv_sec = seconds.count();
+  result.tv_nsec = (time - seconds).count();
+  return result;
+}
+
+/**
+ * Reads the size of the process data of a slave in pre-operational state the way ec_config_map_group() determines
+ * it, from the PDO assignment through CoE or otherwise from the SII. ec_slave[slave].Obytes and Ibytes are only
+ * filled in by the mapping itself, so they cannot size the io map beforehand.
+ */
+size_t readProcessDataSize(uint16 slave)
+{
+  int output_bits = 0;
+  int input_bits = 0;
+  if (ec_slave[slave].mbx_proto & ECT_MBXPROT_COE)
+  {
+    ec_readPDOmap(slave, &output_bits, &input_bits);
+  }
+  if (output_bits == 0 && input_bits == 0)
+  {
+    ec_eepromPDOt pdo;
+    output_bits = ec_siiPDO(slave, &pdo, 0);
+    input_bits = ec_siiPDO(slave, &pdo, 1);
+  }
+  // Rounded up per slave, which is an upper bound for slaves that SOEM packs into shared bytes
+  return (std::max(output_bits, 0) + 7) / 8 + (std::max(input_bits, 0) + 7) / 8;
+}
+}  // namespace
+
+constexpr std::chrono::milliseconds EthercatMaster::SUPERVISOR_PERIOD;
+constexpr std::chrono::seconds EthercatMaster::DIAGNOSTICS_PERIOD;
+constexpr std::chrono::seconds EthercatMaster::SLAVE_RESET_TIMEOUT;
+constexpr std::chrono::milliseconds EthercatMaster::SLAVE_RESET_POLL_PERIOD;
+constexpr std::chrono::milliseconds EthercatMaster::SLOW_GROUP_MAX_PERIOD;
+const size_t EthercatMaster::HISTOGRAM_BUCKET_COUNT;
+
+EthercatMaster::EthercatMaster(std::string ifname, int max_slave_index, int cycle_time_us, int slave_timeout,
+                               int spin_time_us, int slow_group_divider)
   : is_operational_(false)
   , ifname_(std::move(ifname))
   , max_slave_index_(max_slave_index)
-  , cycle_time_ms_(cycle_time)
+  , cycle_time_(cycle_time_us)
+  , spin_time_(spin_time_us)
+  , slow_group_divider_(std::max(slow_group_divider, 1))
+  , group_count_(slow_group_divider > 1 ? 2 : 1)
+  , achieved_period_ns_(0)
+  , phase_error_ns_(0)
+  , send_receive_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
+  , monitor_slaves_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
+  , publish_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
+  , cycle_callback_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
+  , sleep_overshoot_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
+  , period_histogram_(this->getHistogramBucketWidth(), HISTOGRAM_BUCKET_COUNT)
   , slave_watchdog_timeout_(slave_timeout)
+  , slave_counters_(std::make_unique<SlaveCounters[]>(std::max(max_slave_index, 0) + 1))
 {
+  if (spin_time_us < 0 || this->spin_time_ >= this->cycle_time_)
+  {
+    // Spinning for the whole cycle would occupy the real-time core without ever sleeping
+    throw error::HardwareException(error::ErrorType::INVALID_ETHERCAT_CONFIGURATION,
+                                   "Spin time of %d us must be at least 0 and less than the cycle time of %d us",
+                                   spin_time_us, cycle_time_us);
+  }
+  if (this->cycle_time_ * this->slow_group_divider_ > SLOW_GROUP_MAX_PERIOD)
+  {
+    throw error::HardwareException(error::ErrorType::INVALID_ETHERCAT_CONFIGURATION,
+                                   "Slow group divider %d at a cycle time of %d us exceeds the maximum slow group "
+                                   "period of %d ms",
+                                   slow_group_divider, cycle_time_us, static_cast<int>(SLOW_GROUP_MAX_PERIOD.count()));
+  }
+  if (this->group_count_ > 1 && EC_MAXGROUP <= SLOW_GROUP)
+  {
+    // Stock SOEM only has groups 0 and 1, falling back to exchanging all slaves every cycle would hide that
+    throw error::HardwareException(error::ErrorType::INVALID_ETHERCAT_CONFIGURATION,
+                                   "Slow group divider %d needs SOEM built with an EC_MAXGROUP of at least %d, "
+                                   "while it was built with %d",
+                                   slow_group_divider, SLOW_GROUP + 1, EC_MAXGROUP);
+  }
+  this->realtime_config_.priority = EthercatMaster::THREAD_PRIORITY;
 }
 
 EthercatMaster::~EthercatMaster()
@@ -35,14 +127,138 @@ bool EthercatMaster::isOperational() const
 
 int EthercatMaster::getCycleTime() const
 {
-  return this->cycle_time_ms_;
+  return this->cycle_time_.count();
+}
+
+std::chrono::nanoseconds EthercatMaster::getAchievedPeriod() const
+{
+  return std::chrono::nanoseconds(this->achieved_period_ns_.load());
+}
+
+std::chrono::nanoseconds EthercatMaster::getPhaseError() const
+{
+  return std::chrono::nanoseconds(this->phase_error_ns_.load());
+}
+
+EthercatCycleTimings EthercatMaster::getCycleTimings() const
+{
+  EthercatCycleTimings timings;
+  timings.send_receive = this->send_receive_histogram_.getStatistics();
+  timings.monitor_slaves = this->monitor_slaves_histogram_.getStatistics();
+  timings.publish = this->publish_histogram_.getStatistics();
+  timings.cycle_callback = this->cycle_callback_histogram_.getStatistics();
+  timings.sleep_overshoot = this->sleep_overshoot_histogram_.getStatistics();
+  timings.period = this->period_histogram_.getStatistics();
+  return timings;
+}
+
+EthercatDiagnostics EthercatMaster::getDiagnostics() const
+{
+  EthercatDiagnostics diagnostics;
+
+  for (int group = 0; group < this->group_count_; group++)
+  {
+    const GroupCounters& counters = this->group_counters_[group];
+    EthercatGroupDiagnostics group_diagnostics;
+    group_diagnostics.cycles = counters.cycles;
+    group_diagnostics.skipped_cycles = counters.skipped_cycles;
+    group_diagnostics.lost_frames = counters.lost_frames;
+    group_diagnostics.working_counter_shortfalls = counters.working_counter_shortfalls;
+    group_diagnostics.last_working_counter = counters.last_working_counter;
+    group_diagnostics.expected_working_counter = this->expected_working_counters_[group];
+    diagnostics.groups.push_back(group_diagnostics);
+  }
+
+  for (int slave = 1; slave <= this->max_slave_index_; slave++)
+  {
+    const SlaveCounters& counters = this->slave_counters_[slave];
+    EthercatSlaveDiagnostics slave_diagnostics;
+    slave_diagnostics.slave_index = slave;
+    slave_diagnostics.al_state = counters.al_state;
+    slave_diagnostics.al_status_code = counters.al_status_code;
+    slave_diagnostics.al_state_changes = counters.al_state_changes;
+    slave_diagnostics.not_operational = counters.not_operational;
+    slave_diagnostics.recovery_attempts = counters.recovery_attempts;
+    slave_diagnostics.recoveries = counters.recoveries;
+    slave_diagnostics.rx_errors = counters.rx_errors;
+    slave_diagnostics.lost_links = counters.lost_links;
+    diagnostics.slaves.push_back(slave_diagnostics);
+  }
+  return diagnostics;
+}
+
+std::chrono::nanoseconds EthercatMaster::getHistogramBucketWidth() const
+{
+  const std::chrono::nanoseconds width = 2 * std::chrono::nanoseconds(this->cycle_time_) / HISTOGRAM_BUCKET_COUNT;
+  return std::max(width, std::chrono::nanoseconds(1));
+}
+
+void EthercatMaster::setCycleCallback(CycleCallback callback)
+{
+  if (this->has_cycle_callback_ || this->process_image_handoff_)
+  {
+    throw std::logic_error("A cycle callback cannot be set after a cycle callback was set or waitForPdo was called");
+  }
+  this->cycle_callback_ = std::move(callback);
+  this->has_cycle_callback_.store(true, std::memory_order_release);
+}
+
+bool EthercatMaster::waitForPdo()
+{
+  if (this->has_cycle_callback_)
+  {
+    throw std::logic_error("Cannot wait for PDO when a cycle callback is set");
+  }
+  if (!this->is_operational_)
+  {
+    return false;
+  }
+  if (!this->process_image_handoff_)
+  {
+    this->startProcessImageHandoff();
+  }
+
+  uint8_t* application_map = this->application_map_.data();
+  this->process_image_.commitOutputs(application_map);
+  if (!this->process_image_.waitForInputs(this->last_input_sequence_))
+  {
+    return false;
+  }
+  this->last_input_sequence_ = this->process_image_.acquireInputs(application_map);
+  return true;
+}
+
+bool EthercatMaster::waitForCycle()
+{
+  if (this->process_image_handoff_)
+  {
+    return this->waitForPdo();
+  }
+  if (this->has_cycle_callback_)
+  {
+    throw std::logic_error("Cannot wait for a cycle when a cycle callback is set");
+  }
+  return this->is_operational_ && this->process_image_.waitForInputs(this->process_image_.getSequence());
 }
 
-void EthercatMaster::waitForPdo()
+void EthercatMaster::startProcessImageHandoff()
 {
-  std::unique_lock<std::mutex> lock(this->wait_on_pdo_condition_mutex_);
-  this->wait_on_pdo_condition_var_.wait(lock, [&] { return this->pdo_received_ || !this->is_operational_; });
-  this->pdo_received_ = false;
+  uint8_t* io_map = this->io_map_.data();
+  uint8_t* application_map = this->application_map_.data();
+  std::memcpy(application_map, io_map, this->io_map_.size());
+
+  for (int slave = 1; slave <= ec_slavecount; slave++)
+  {
+    if (ec_slave[slave].outputs != nullptr)
+    {
+      ec_slave[slave].outputs = application_map + (ec_slave[slave].outputs - io_map);
+    }
+    if (ec_slave[slave].inputs != nullptr)
+    {
+      ec_slave[slave].inputs = application_map + (ec_slave[slave].inputs - io_map);
+    }
+  }
+  this->process_image_handoff_ = true;
 }
 
 std::exception_ptr EthercatMaster::getLastException() const noexcept
@@ -50,24 +266,45 @@ std::exception_ptr EthercatMaster::getLastException() const noexcept
   return this->last_exception_;
 }
 
-bool EthercatMaster::start(std::vector<Joint>& joints)
+void EthercatMaster::setRealtimeConfig(RealtimeConfig config)
+{
+  if (this->ethercat_thread_.joinable())
+  {
+    throw std::logic_error("The real-time config cannot be changed while the ethercat loop is running");
+  }
+  this->realtime_config_ = std::move(config);
+}
+
+void EthercatMaster::start(std::vector<Joint>& joints, bool reset_imc)
 {
   this->last_exception_ = nullptr;
+  this->startup_timeline_.clear();
+  const auto start_time = StartupTimeline::Clock::now();
   this->ethercatMasterInitiation();
-  return this->ethercatSlaveInitiation(joints);
+  this->ethercatSlaveInitiation(joints, reset_imc);
+  this->startup_timeline_.record("start EtherCAT", start_time);
+}
+
+StartupTimeline& EthercatMaster::getStartupTimeline()
+{
+  return this->startup_timeline_;
 }
 
 void EthercatMaster::ethercatMasterInitiation()
 {
   ROS_INFO("Trying to start EtherCAT");
+  auto start_time = StartupTimeline::Clock::now();
   if (!ec_init(this->ifname_.c_str()))
   {
     throw error::HardwareException(error::ErrorType::NO_SOCKET_CONNECTION, "No socket connection on %s",
                                    this->ifname_.c_str());
   }
+  this->startup_timeline_.record("ec_init", start_time);
   ROS_INFO("ec_init on %s succeeded", this->ifname_.c_str());
 
+  start_time = StartupTimeline::Clock::now();
   const int slave_count = ec_config_init(FALSE);
+  this->startup_timeline_.record("ec_config_init", start_time);
   if (slave_count < this->max_slave_index_)
   {
     ec_close();
@@ -78,20 +315,27 @@ void EthercatMaster::ethercatMasterInitiation()
   ROS_INFO("%d slave(s) found and initialized.", slave_count);
 }
 
+// Watchdog time of the IMotionCubes, set before the slaves are configured since SOEM only accepts a plain function
+// as PO2SO hook.
+static uint16 slave_watchdog_time = IMotionCube::WATCHDOG_MIN_TIME;
+
 int setSlaveWatchdogTimer(uint16 slave)
 {
   uint16 configadr = ec_slave[slave].configadr;
   ec_FPWRw(configadr, 0x0400, IMotionCube::WATCHDOG_DIVIDER, EC_TIMEOUTRET);  // Set the divider register of the WD
-  ec_FPWRw(configadr, 0x0410, IMotionCube::WATCHDOG_TIME, EC_TIMEOUTRET);     // Set the PDI watchdog = WD
-  ec_FPWRw(configadr, 0x0420, IMotionCube::WATCHDOG_TIME, EC_TIMEOUTRET);     // Set the SM watchdog = WD
+  ec_FPWRw(configadr, 0x0410, slave_watchdog_time, EC_TIMEOUTRET);            // Set the PDI watchdog = WD
+  ec_FPWRw(configadr, 0x0420, slave_watchdog_time, EC_TIMEOUTRET);            // Set the SM watchdog = WD
   return 1;
 }
 
-bool EthercatMaster::ethercatSlaveInitiation(std::vector<Joint>& joints)
+void EthercatMaster::ethercatSlaveInitiation(std::vector<Joint>& joints, bool reset_imc)
 {
   ROS_INFO("Request pre-operational state for all slaves");
-  bool reset = false;
+  auto start_time = StartupTimeline::Clock::now();
   ec_statecheck(0, EC_STATE_PRE_OP, EC_TIMEOUTSTATE * 4);
+  this->startup_timeline_.record("pre-operational state", start_time);
+
+  slave_watchdog_time = IMotionCube::getWatchdogTime(this->cycle_time_.count());
 
   for (Joint& joint : joints)
   {
@@ -99,38 +343,66 @@ bool EthercatMaster::ethercatSlaveInitiation(std::vector<Joint>& joints)
     {
       ec_slave[joint.getIMotionCubeSlaveIndex()].PO2SOconfig = setSlaveWatchdogTimer;
     }
-    reset |= joint.initialize(this->cycle_time_ms_);
   }
+  std::vector<Joint*> all_joints;
+  for (Joint& joint : joints)
+  {
+    all_joints.push_back(&joint);
+  }
+  std::vector<Joint*> reset_joints = this->initializeJoints(all_joints);
+  if (reset_imc)
+  {
+    reset_joints.clear();
+    std::copy_if(all_joints.begin(), all_joints.end(), std::back_inserter(reset_joints),
+                 [](const Joint* joint) { return joint->hasIMotionCube(); });
+  }
+  if (!reset_joints.empty())
+  {
+    this->resetJoints(reset_joints);
+  }
+
+  start_time = StartupTimeline::Clock::now();
+  this->configureGroups(joints);
+  this->startup_timeline_.record("map process data", start_time);
 
-  ec_config_map(&this->io_map_);
+  start_time = StartupTimeline::Clock::now();
   ec_configdc();
+  this->startup_timeline_.record("ec_configdc", start_time);
 
   ROS_INFO("Request safe-operational state for all slaves");
+  start_time = StartupTimeline::Clock::now();
   ec_statecheck(0, EC_STATE_SAFE_OP, EC_TIMEOUTSTATE * 4);
+  this->startup_timeline_.record("safe-operational state", start_time);
 
-  this->expected_working_counter_ = (ec_group[0].outputsWKC * 2) + ec_group[0].inputsWKC;
+  for (int group = 0; group < this->group_count_; group++)
+  {
+    const ec_groupt& soem_group = ec_group[this->getSoemGroup(group)];
+    this->expected_working_counters_[group] = (soem_group.outputsWKC * 2) + soem_group.inputsWKC;
+  }
   ec_slave[0].state = EC_STATE_OPERATIONAL;
 
-  ec_send_processdata();
-  ec_receive_processdata(EC_TIMEOUTRET);
+  this->sendReceiveAllGroups();
 
   ROS_INFO("Request operational state for all slaves");
+  start_time = StartupTimeline::Clock::now();
   ec_writestate(0);
   int chk = 40;
 
   do
   {
-    ec_send_processdata();
-    ec_receive_processdata(EC_TIMEOUTRET);
+    this->sendReceiveAllGroups();
     ec_statecheck(0, EC_STATE_OPERATIONAL, 50000);
   } while (chk-- && (ec_slave[0].state != EC_STATE_OPERATIONAL));
 
+  this->startup_timeline_.record("operational state", start_time);
+
   if (ec_slave[0].state == EC_STATE_OPERATIONAL)
   {
     ROS_INFO("Operational state reached for all slaves");
     this->is_operational_ = true;
     this->ethercat_thread_ = std::thread(&EthercatMaster::ethercatLoop, this);
-    this->setThreadPriority(EthercatMaster::THREAD_PRIORITY);
+    this->supervisor_thread_ = std::thread(&EthercatMaster::supervisorLoop, this);
+    this->setThreadPriority(this->supervisor_thread_, EthercatMaster::SUPERVISOR_THREAD_PRIORITY);
   }
   else
   {
@@ -149,39 +421,304 @@ bool EthercatMaster::ethercatSlaveInitiation(std::vector<Joint>& joints)
     throw error::HardwareException(error::ErrorType::FAILED_TO_REACH_OPERATIONAL_STATE, "Not operational slaves: %s",
                                    ss.str().c_str());
   }
-  return reset;
+}
+
+std::vector<Joint*> EthercatMaster::initializeJoints(const std::vector<Joint*>& joints)
+{
+  const int cycle_time = this->cycle_time_.count();
+  const auto start_time = std::chrono::steady_clock::now();
+
+  // SOEM handles one SDO round trip at a time, so the joints are initialized one after the other
+  std::vector<Joint*> reset_joints;
+  for (Joint* joint : joints)
+  {
+    const auto joint_start_time = std::chrono::steady_clock::now();
+    const size_t sdo_transfers = joint->getSdoTransferCount();
+    if (joint->initialize(cycle_time))
+    {
+      reset_joints.push_back(joint);
+    }
+    this->startup_timeline_.record("initialize " + joint->getName(), joint_start_time,
+                                   std::max(joint->getIMotionCubeSlaveIndex(), 0),
+                                   joint->getSdoTransferCount() - sdo_transfers);
+    const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - joint_start_time;
+    ROS_INFO("[%s] Initialized in %.3f s", joint->getName().c_str(), duration.count());
+  }
+
+  this->startup_timeline_.record("initialize joints", start_time);
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_time;
+  ROS_INFO("Initialized %zu joints in %.3f s", joints.size(), duration.count());
+  return reset_joints;
+}
+
+void EthercatMaster::resetJoints(const std::vector<Joint*>& joints)
+{
+  const auto start_time = std::chrono::steady_clock::now();
+
+  // All drives are reset before waiting for any, so they reboot at the same time
+  for (Joint* joint : joints)
+  {
+    ROS_INFO("[%s] Resetting IMotionCube", joint->getName().c_str());
+    joint->resetIMotionCube();
+  }
+  for (const Joint* joint : joints)
+  {
+    const int slave = joint->getIMotionCubeSlaveIndex();
+    const auto recover_start_time = StartupTimeline::Clock::now();
+    const bool recovered = this->recoverResetSlave(slave);
+    this->startup_timeline_.record("recover " + joint->getName(), recover_start_time, slave);
+    if (!recovered)
+    {
+      throw error::HardwareException(error::ErrorType::SLAVE_RESET_FAILED,
+                                     "Slave %d of joint %s did not return to pre-operational state after %ld s", slave,
+                                     joint->getName().c_str(), static_cast<long>(SLAVE_RESET_TIMEOUT.count()));
+    }
+  }
+
+  if (!this->initializeJoints(joints).empty())
+  {
+    ROS_WARN("A new setup was downloaded again after resetting the IMotionCubes");
+  }
+
+  this->startup_timeline_.record("reset joints", start_time);
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_time;
+  ROS_INFO("Reset and initialized %zu joints in %.3f s", joints.size(), duration.count());
+}
+
+bool EthercatMaster::recoverResetSlave(int slave)
+{
+  const auto deadline = std::chrono::steady_clock::now() + SLAVE_RESET_TIMEOUT;
+
+  // The slave still answers in pre-operational state until the drive actually reboots
+  uint16 state = EC_STATE_PRE_OP;
+  while ((state & 0x0F) == EC_STATE_PRE_OP && std::chrono::steady_clock::now() < deadline)
+  {
+    std::this_thread::sleep_for(SLAVE_RESET_POLL_PERIOD);
+    state = ec_statecheck(slave, EC_STATE_INIT, EC_TIMEOUTRET);
+  }
+
+  while (std::chrono::steady_clock::now() < deadline)
+  {
+    if (state == EC_STATE_NONE)
+    {
+      // The slave lost its configured address during the reboot
+      ec_recover_slave(slave, EC_TIMEOUTRET3);
+    }
+    else
+    {
+      // The rebooted slave lost its mailbox configuration. Only the mailbox is reprogrammed, since the process data
+      // is configured later when the groups are mapped, instead of ec_reconfig_slave() which continues to safe-op.
+      const uint16 configadr = ec_slave[slave].configadr;
+      ec_FPWRw(configadr, ECT_REG_ALCTL, htoes(EC_STATE_INIT | EC_STATE_ACK), EC_TIMEOUTRET3);
+      ec_eeprom2pdi(slave);
+      if ((ec_statecheck(slave, EC_STATE_INIT, EC_TIMEOUTSTATE) & 0x0F) == EC_STATE_INIT)
+      {
+        for (uint16 sm = 0; sm < 2; sm++)
+        {
+          if (ec_slave[slave].SM[sm].StartAddr)
+          {
+            ec_FPWR(configadr, ECT_REG_SM0 + sm * sizeof(ec_smt), sizeof(ec_smt), &ec_slave[slave].SM[sm],
+                    EC_TIMEOUTRET3);
+          }
+        }
+      }
+      // Acknowledges the error that the AL status of a slave often reports after a reset
+      ec_slave[slave].state = EC_STATE_PRE_OP | EC_STATE_ACK;
+      ec_writestate(slave);
+    }
+    state = ec_statecheck(slave, EC_STATE_PRE_OP, EC_TIMEOUTSTATE);
+    if ((state & 0x0F) == EC_STATE_PRE_OP)
+    {
+      ec_slave[slave].islost = FALSE;
+      ROS_INFO("Slave %d returned to pre-operational state after reset", slave);
+      return true;
+    }
+    std::this_thread::sleep_for(SLAVE_RESET_POLL_PERIOD);
+  }
+  return false;
+}
+
+int EthercatMaster::getSoemGroup(int group) const
+{
+  return this->group_count_ > 1 ? FAST_GROUP + group : ALL_SLAVES_GROUP;
+}
+
+void EthercatMaster::configureGroups(const std::vector<Joint>& joints)
+{
+  if (this->group_count_ > 1)
+  {
+    // Only the IMotionCubes are exchanged every cycle, all other slaves are exchanged in the slow group
+    for (int slave = 1; slave <= ec_slavecount; slave++)
+    {
+      ec_slave[slave].group = SLOW_GROUP;
+    }
+    for (const Joint& joint : joints)
+    {
+      if (joint.hasIMotionCube())
+      {
+        ec_slave[joint.getIMotionCubeSlaveIndex()].group = FAST_GROUP;
+      }
+    }
+  }
+
+  // SOEM stores pointers into the io map while mapping, so it is sized from the process data of the slaves first
+  std::vector<size_t> group_sizes(this->group_count_, 0);
+  for (int slave = 1; slave <= ec_slavecount; slave++)
+  {
+    for (int group = 0; group < this->group_count_; group++)
+    {
+      const int soem_group = this->getSoemGroup(group);
+      if (soem_group == ALL_SLAVES_GROUP || ec_slave[slave].group == soem_group)
+      {
+        group_sizes[group] += readProcessDataSize(slave);
+      }
+    }
+  }
+  size_t io_map_size = 0;
+  for (size_t group_size : group_sizes)
+  {
+    io_map_size += group_size;
+  }
+  if (io_map_size > MAX_IO_MAP_SIZE)
+  {
+    throw error::HardwareException(error::ErrorType::IO_MAP_OVERFLOW,
+                                   "The process data of %zu bytes does not fit in at most %zu bytes", io_map_size,
+                                   MAX_IO_MAP_SIZE);
+  }
+  this->io_map_.allocate(io_map_size);
+  this->application_map_.allocate(io_map_size);
+  uint8_t* io_map = this->io_map_.data();
+
+  size_t mapped_size = 0;
+  for (int group = 0; group < this->group_count_; group++)
+  {
+    // Every group is mapped behind the previous one, both in the io map and in the logical address space
+    const int soem_group = this->getSoemGroup(group);
+    ec_group[soem_group].logstartaddr = mapped_size;
+    const size_t group_size = ec_config_map_group(io_map + mapped_size, soem_group);
+    if (group_size > group_sizes[group])
+    {
+      throw error::HardwareException(error::ErrorType::IO_MAP_OVERFLOW,
+                                     "Group %d mapped %zu bytes while its process data was read as %zu bytes",
+                                     soem_group, group_size, group_sizes[group]);
+    }
+    mapped_size += group_size;
+  }
+
+  std::vector<ProcessImage::Range> outputs;
+  std::vector<ProcessImage::Range> inputs;
+  for (int group = 0; group < this->group_count_; group++)
+  {
+    const int soem_group = this->getSoemGroup(group);
+    outputs.push_back({ static_cast<size_t>(ec_group[soem_group].outputs - io_map), ec_group[soem_group].Obytes });
+    inputs.push_back({ static_cast<size_t>(ec_group[soem_group].inputs - io_map), ec_group[soem_group].Ibytes });
+    ROS_INFO("Mapped %u output and %u input bytes in group %d", ec_group[soem_group].Obytes,
+             ec_group[soem_group].Ibytes, soem_group);
+  }
+
+  ROS_INFO("Mapped %zu bytes in an io map of %zu bytes", mapped_size, this->io_map_.size());
+  if (!this->io_map_.isLocked() || !this->application_map_.isLocked())
+  {
+    ROS_WARN("Failed to lock the io map in memory, accessing process data may cause page faults");
+  }
+
+  this->process_image_.configure(std::move(outputs), std::move(inputs));
+  this->process_image_handoff_ = false;
+  this->last_input_sequence_ = 0;
+}
+
+void EthercatMaster::sendReceiveAllGroups()
+{
+  // SOEM receives all outstanding frames at once, so every group is received before the next one is sent
+  for (int group = 0; group < this->group_count_; group++)
+  {
+    ec_send_processdata_group(this->getSoemGroup(group));
+    ec_receive_processdata_group(this->getSoemGroup(group), EC_TIMEOUTRET);
+  }
 }
 
 void EthercatMaster::ethercatLoop()
 {
+  // Applied by the thread itself, so the first cycle already runs with the granted settings
+  const RealtimeReport realtime_report = applyRealtimeConfig(this->realtime_config_);
+  ROS_INFO_STREAM("EtherCAT thread real-time settings: " << realtime_report);
+
   size_t total_loops = 0;
   size_t not_achieved_count = 0;
-  const size_t rate = 1000 / this->cycle_time_ms_;
-  const std::chrono::milliseconds cycle_time(this->cycle_time_ms_);
+  const size_t rate = std::chrono::seconds(1) / this->cycle_time_;
+  const std::chrono::nanoseconds cycle_time = this->cycle_time_;
+
+  std::chrono::nanoseconds deadline = monotonicNow();
+  std::chrono::nanoseconds last_wakeup = deadline;
+  bool first_cycle = true;
+  size_t cycle = 0;
+  uint8_t* io_map = this->io_map_.data();
+  this->valid_slaves_timestamp_ms_ = std::chrono::high_resolution_clock::now();
 
   while (this->is_operational_)
   {
-    const auto begin_time = std::chrono::high_resolution_clock::now();
-
-    const bool pdo_received = this->sendReceivePdo();
-    this->monitorSlaveConnection();
-
-    const auto end_time = std::chrono::high_resolution_clock::now();
-    const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - begin_time);
+    deadline += cycle_time;
+    const std::chrono::nanoseconds wakeup = this->sleepUntil(deadline);
+    this->phase_error_ns_ = (wakeup - deadline).count();
+    this->achieved_period_ns_ = (wakeup - last_wakeup).count();
+    this->sleep_overshoot_histogram_.record(wakeup - deadline);
+    if (!first_cycle)
+    {
+      this->period_histogram_.record(wakeup - last_wakeup);
+    }
+    first_cycle = false;
+    last_wakeup = wakeup;
+
+    this->process_image_.fetchOutputs(io_map);
+    const bool slow_cycle = cycle++ % this->slow_group_divider_ == 0;
+    const bool pdo_received = this->sendReceivePdo(slow_cycle ? this->group_count_ : 1);
+    const std::chrono::nanoseconds send_receive_time = monotonicNow();
+    this->send_receive_histogram_.record(send_receive_time - wakeup);
+    const bool cycle_callback = this->has_cycle_callback_.load(std::memory_order_acquire);
+    if (pdo_received)
+    {
+      this->valid_slaves_timestamp_ms_ = std::chrono::high_resolution_clock::now();
+      if (cycle_callback)
+      {
+        try
+        {
+          this->cycle_callback_();
+        }
+        catch (...)
+        {
+          this->last_exception_ = std::current_exception();
+          this->is_operational_ = false;
+        }
+      }
+      else
+      {
+        this->process_image_.publishInputs(io_map);
+      }
+    }
 
+    const std::chrono::nanoseconds end_time = monotonicNow();
+    if (cycle_callback)
+    {
+      this->cycle_callback_histogram_.record(end_time - send_receive_time);
+    }
+    else
+    {
+      this->publish_histogram_.record(end_time - send_receive_time);
+    }
+    if (!this->is_operational_)
     {
-      std::lock_guard<std::mutex> lock(this->wait_on_pdo_condition_mutex_);
-      this->pdo_received_ = pdo_received;
+      // Stopped by stop() or by the cycle callback
+      break;
     }
-    this->wait_on_pdo_condition_var_.notify_one();
 
-    if (duration > cycle_time)
+    if (end_time - wakeup > cycle_time)
     {
       not_achieved_count++;
     }
-    else
+    if (end_time - deadline >= cycle_time)
     {
-      std::this_thread::sleep_for(cycle_time - duration);
+      // Skip the periods that were missed entirely, instead of sending a burst of frames to catch up.
+      deadline += ((end_time - deadline) / cycle_time) * cycle_time;
     }
     total_loops++;
 
@@ -190,8 +727,8 @@ void EthercatMaster::ethercatLoop()
       const double not_achieved_percentage = 100.0 * ((double)not_achieved_count / total_loops);
       if (not_achieved_percentage > 5.0)
       {
-        ROS_WARN("EtherCAT rate of %d milliseconds per cycle was not achieved for %f percent of all cycles",
-                 this->cycle_time_ms_, not_achieved_percentage);
+        ROS_WARN("EtherCAT rate of %ld microseconds per cycle was not achieved for %f percent of all cycles",
+                 this->cycle_time_.count(), not_achieved_percentage);
       }
       total_loops = 0;
       not_achieved_count = 0;
@@ -205,27 +742,143 @@ void EthercatMaster::ethercatLoop()
     {
       this->last_exception_ = std::make_exception_ptr(error::HardwareException(
           error::ErrorType::SLAVE_LOST_TIMOUT, "Slave connection lost for %i ms from slave %i and onwards.",
-          this->slave_watchdog_timeout_, this->latest_lost_slave_));
+          this->slave_watchdog_timeout_, this->latest_lost_slave_.load()));
       this->is_operational_ = false;
-      this->wait_on_pdo_condition_var_.notify_one();
+    }
+  }
+
+  this->process_image_.interrupt();
+  this->supervisor_thread_.join();
+  this->closeEthercat();
+}
+
+void EthercatMaster::supervisorLoop()
+{
+  std::chrono::nanoseconds last_diagnostics_time = monotonicNow();
+  while (this->is_operational_)
+  {
+    std::this_thread::sleep_for(EthercatMaster::SUPERVISOR_PERIOD);
+
+    if (this->slave_check_requested_.exchange(false) || this->latest_lost_slave_ != -1)
+    {
+      const std::chrono::nanoseconds start_time = monotonicNow();
+      this->monitorSlaveConnection();
+      this->monitor_slaves_histogram_.record(monotonicNow() - start_time);
+    }
+
+    if (monotonicNow() - last_diagnostics_time >= EthercatMaster::DIAGNOSTICS_PERIOD)
+    {
+      last_diagnostics_time = monotonicNow();
+      ec_readstate();
+      this->updateSlaveStates();
+      this->updateSlaveErrorCounters();
+    }
+  }
+}
 
-      this->closeEthercat();
+void EthercatMaster::updateSlaveStates()
+{
+  const int slave_count = std::min(ec_slavecount, this->max_slave_index_);
+  for (int slave = 1; slave <= slave_count; slave++)
+  {
+    SlaveCounters& counters = this->slave_counters_[slave];
+    if (counters.al_state != ec_slave[slave].state)
+    {
+      counters.al_state_changes++;
+      counters.al_state = ec_slave[slave].state;
     }
+    counters.al_status_code = ec_slave[slave].ALstatuscode;
   }
 }
 
-bool EthercatMaster::sendReceivePdo()
+void EthercatMaster::updateSlaveErrorCounters()
+{
+  const int slave_count = std::min(ec_slavecount, this->max_slave_index_);
+  for (int slave = 1; slave <= slave_count; slave++)
+  {
+    // Invalid frame and RX error counter for each of the 4 ports
+    uint8 rx_error_counters[8] = { 0 };
+    // Lost link counter for each of the 4 ports
+    uint8 lost_link_counters[4] = { 0 };
+
+    const uint16 configadr = ec_slave[slave].configadr;
+    if (ec_FPRD(configadr, 0x0300, sizeof(rx_error_counters), rx_error_counters, EC_TIMEOUTRET) <= 0 ||
+        ec_FPRD(configadr, 0x0310, sizeof(lost_link_counters), lost_link_counters, EC_TIMEOUTRET) <= 0)
+    {
+      continue;
+    }
+
+    uint32_t rx_errors = 0;
+    for (uint8 count : rx_error_counters)
+    {
+      rx_errors += count;
+    }
+    uint32_t lost_links = 0;
+    for (uint8 count : lost_link_counters)
+    {
+      lost_links += count;
+    }
+    this->slave_counters_[slave].rx_errors = rx_errors;
+    this->slave_counters_[slave].lost_links = lost_links;
+  }
+}
+
+std::chrono::nanoseconds EthercatMaster::sleepUntil(std::chrono::nanoseconds deadline) const
+{
+  const timespec sleep_deadline = toTimespec(deadline - this->spin_time_);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &sleep_deadline, nullptr) == EINTR)
+  {
+  }
+
+  std::chrono::nanoseconds now = monotonicNow();
+  while (now < deadline)
+  {
+    now = monotonicNow();
+  }
+  return now;
+}
+
+bool EthercatMaster::sendReceivePdo(int group_count)
 {
   if (this->latest_lost_slave_ == -1)
   {
-    ec_send_processdata();
-    const int wkc = ec_receive_processdata(EC_TIMEOUTRET);
-    if (wkc < this->expected_working_counter_)
+    // SOEM receives all outstanding frames at once, whatever their group, so every group is received before
+    // the next one is sent. The fast group goes first, so its inputs are not delayed by the slow group.
+    bool received = true;
+    for (int group = 0; group < group_count; group++)
     {
-      ROS_WARN_THROTTLE(1, "Working counter: %d  is lower than expected: %d", wkc, this->expected_working_counter_);
-      return false;
+      GroupCounters& counters = this->group_counters_[group];
+      const int soem_group = this->getSoemGroup(group);
+      const int expected_wkc = this->expected_working_counters_[group];
+      ec_send_processdata_group(soem_group);
+      const int wkc = ec_receive_processdata_group(soem_group, EC_TIMEOUTRET);
+      counters.cycles.fetch_add(1, std::memory_order_relaxed);
+      counters.last_working_counter.store(wkc, std::memory_order_relaxed);
+      if (wkc < expected_wkc)
+      {
+        if (wkc <= 0)
+        {
+          counters.lost_frames.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+          counters.working_counter_shortfalls.fetch_add(1, std::memory_order_relaxed);
+        }
+        this->slave_check_requested_ = true;
+        ROS_WARN_THROTTLE(1, "Working counter: %d  is lower than expected: %d in group %d", wkc, expected_wkc,
+                          soem_group);
+        // A shortfall of the slow group is recovered by the supervisor without holding back the fast group inputs
+        if (group == 0)
+        {
+          received = false;
+        }
+      }
     }
-    return true;
+    return received;
+  }
+  for (int group = 0; group < group_count; group++)
+  {
+    this->group_counters_[group].skipped_cycles.fetch_add(1, std::memory_order_relaxed);
   }
   return false;
 }
@@ -233,17 +886,27 @@ bool EthercatMaster::sendReceivePdo()
 void EthercatMaster::monitorSlaveConnection()
 {
   ec_readstate();
+  this->updateSlaveStates();
   for (int slave = 1; slave <= ec_slavecount; slave++)
   {
     if (ec_slave[slave].state != EC_STATE_OPERATIONAL)
     {
       ROS_WARN_THROTTLE(1, "EtherCAT train lost connection from slave %d onwards", slave);
+      if (slave <= this->max_slave_index_)
+      {
+        this->slave_counters_[slave].not_operational++;
+        this->slave_counters_[slave].recovery_attempts++;
+      }
 
       if (!this->attemptSlaveRecover(slave))
       {
         this->latest_lost_slave_ = slave;
         return;
       }
+      if (slave <= this->max_slave_index_)
+      {
+        this->slave_counters_[slave].recoveries++;
+      }
     }
   }
 
@@ -253,7 +916,6 @@ void EthercatMaster::monitorSlaveConnection()
   }
 
   this->latest_lost_slave_ = -1;
-  this->valid_slaves_timestamp_ms_ = std::chrono::high_resolution_clock::now();
 }
 
 bool EthercatMaster::attemptSlaveRecover(int slave)
@@ -330,25 +992,28 @@ void EthercatMaster::stop()
   {
     ROS_INFO("Stopping EtherCAT");
     this->is_operational_ = false;
-    this->ethercat_thread_.join();
+  }
 
-    this->closeEthercat();
+  // The ethercat loop closes the connection when it stops, which is also when stopped from the cycle callback
+  if (this->ethercat_thread_.joinable() && this->ethercat_thread_.get_id() != std::this_thread::get_id())
+  {
+    this->ethercat_thread_.join();
   }
 }
 
-void EthercatMaster::setThreadPriority(int priority)
+void EthercatMaster::setThreadPriority(std::thread& thread, int priority)
 {
   struct sched_param param = { priority };
   // SCHED_FIFO scheduling preempts other threads with lower priority as soon as it becomes runnable.
   // See http://man7.org/linux/man-pages/man7/sched.7.html for more info.
-  const int error = pthread_setschedparam(this->ethercat_thread_.native_handle(), SCHED_FIFO, &param);
+  const int error = pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
   if (error != 0)
   {
-    ROS_ERROR("Failed to set the ethercat thread priority to %d. (error code: %d)", priority, error);
+    ROS_ERROR("Failed to set the thread priority to %d. (error code: %d)", priority, error);
   }
   else
   {
-    ROS_DEBUG("Set ethercat thread priority to %d", param.sched_priority);
+    ROS_DEBUG("Set thread priority to %d", param.sched_priority);
   }
 }
 }  // namespace march
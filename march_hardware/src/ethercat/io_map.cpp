@@ -0,0 +1,64 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/io_map.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#include <sys/mman.h>
+
+namespace march
+{
+IoMap::~IoMap()
+{
+  this->release();
+}
+
+void IoMap::allocate(size_t size)
+{
+  this->release();
+
+  // Round up to whole cache lines, so no other data shares the last cache line
+  const size_t aligned_size = ((size + IoMap::ALIGNMENT - 1) / IoMap::ALIGNMENT) * IoMap::ALIGNMENT;
+  void* data = nullptr;
+  if (aligned_size > 0 && posix_memalign(&data, IoMap::ALIGNMENT, aligned_size) != 0)
+  {
+    throw std::bad_alloc();
+  }
+
+  this->data_ = static_cast<uint8_t*>(data);
+  this->size_ = aligned_size;
+  if (this->data_ != nullptr)
+  {
+    std::memset(this->data_, 0, this->size_);
+    this->locked_ = mlock(this->data_, this->size_) == 0;
+  }
+}
+
+uint8_t* IoMap::data() const
+{
+  return this->data_;
+}
+
+size_t IoMap::size() const
+{
+  return this->size_;
+}
+
+bool IoMap::isLocked() const
+{
+  return this->locked_;
+}
+
+void IoMap::release()
+{
+  if (this->locked_)
+  {
+    munlock(this->data_, this->size_);
+  }
+  std::free(this->data_);
+  this->data_ = nullptr;
+  this->size_ = 0;
+  this->locked_ = false;
+}
+}  // namespace march
@@ -0,0 +1,102 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/latency_histogram.h"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace march
+{
+LatencyHistogram::LatencyHistogram(std::chrono::nanoseconds bucket_width, size_t bucket_count)
+  : bucket_width_ns_(bucket_width.count())
+  , bucket_count_(bucket_count)
+  , count_(0)
+  , sum_ns_(0)
+  , min_ns_(std::numeric_limits<int64_t>::max())
+  , max_ns_(0)
+{
+  if (this->bucket_width_ns_ <= 0 || this->bucket_count_ == 0)
+  {
+    throw std::invalid_argument("Latency histogram requires a positive bucket width and at least one bucket");
+  }
+  this->buckets_ = std::make_unique<std::atomic<uint64_t>[]>(this->bucket_count_ + 1);
+  for (size_t i = 0; i <= this->bucket_count_; i++)
+  {
+    this->buckets_[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+void LatencyHistogram::record(std::chrono::nanoseconds duration)
+{
+  const int64_t duration_ns = std::max<int64_t>(duration.count(), 0);
+  const size_t bucket = std::min<size_t>(duration_ns / this->bucket_width_ns_, this->bucket_count_);
+
+  // Only a single thread records, so plain loads and stores suffice for min and max.
+  if (duration_ns < this->min_ns_.load(std::memory_order_relaxed))
+  {
+    this->min_ns_.store(duration_ns, std::memory_order_relaxed);
+  }
+  if (duration_ns > this->max_ns_.load(std::memory_order_relaxed))
+  {
+    this->max_ns_.store(duration_ns, std::memory_order_relaxed);
+  }
+  this->sum_ns_.fetch_add(duration_ns, std::memory_order_relaxed);
+  this->buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+  this->count_.fetch_add(1, std::memory_order_release);
+}
+
+LatencyStatistics LatencyHistogram::getStatistics() const
+{
+  LatencyStatistics statistics;
+  const uint64_t count = this->count_.load(std::memory_order_acquire);
+  if (count == 0)
+  {
+    return statistics;
+  }
+
+  std::vector<uint64_t> buckets(this->bucket_count_ + 1);
+  uint64_t bucket_total = 0;
+  for (size_t i = 0; i <= this->bucket_count_; i++)
+  {
+    buckets[i] = this->buckets_[i].load(std::memory_order_relaxed);
+    bucket_total += buckets[i];
+  }
+
+  const int64_t max_ns = this->max_ns_.load(std::memory_order_relaxed);
+  const auto percentile = [&](double fraction) {
+    const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * bucket_total + 0.5));
+    uint64_t cumulative = 0;
+    for (size_t i = 0; i < this->bucket_count_; i++)
+    {
+      cumulative += buckets[i];
+      if (cumulative >= rank)
+      {
+        return std::chrono::nanoseconds(std::min<int64_t>((i + 1) * this->bucket_width_ns_, max_ns));
+      }
+    }
+    return std::chrono::nanoseconds(max_ns);
+  };
+
+  statistics.count = count;
+  statistics.min = std::chrono::nanoseconds(this->min_ns_.load(std::memory_order_relaxed));
+  statistics.max = std::chrono::nanoseconds(max_ns);
+  statistics.mean = std::chrono::nanoseconds(this->sum_ns_.load(std::memory_order_relaxed) / count);
+  statistics.p50 = percentile(0.5);
+  statistics.p90 = percentile(0.9);
+  statistics.p99 = percentile(0.99);
+  statistics.p999 = percentile(0.999);
+  return statistics;
+}
+
+std::chrono::nanoseconds LatencyHistogram::getBucketWidth() const
+{
+  return std::chrono::nanoseconds(this->bucket_width_ns_);
+}
+
+size_t LatencyHistogram::getBucketCount() const
+{
+  return this->bucket_count_;
+}
+
+}  // namespace march
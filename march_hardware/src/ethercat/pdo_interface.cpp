@@ -1,5 +1,6 @@
 // Copyright 2019 Project March.
 #include "march_hardware/ethercat/pdo_interface.h"
+#include "march_hardware/ethercat/pdo_buffer.h"
 #include "march_hardware/ethercat/pdo_types.h"
 
 #include <cstdint>
@@ -10,60 +11,41 @@ namespace march
 {
 void PdoInterfaceImpl::write8(uint16_t slave_index, uint8_t module_index, bit8 value)
 {
-  uint8_t* data_ptr = ec_slave[slave_index].outputs + module_index;
-
-  *data_ptr = value.b0;
+  PdoBuffer(nullptr, ec_slave[slave_index].outputs).write8(module_index, value);
 }
 
 void PdoInterfaceImpl::write16(uint16_t slave_index, uint8_t module_index, bit16 value)
 {
-  uint8_t* data_ptr = ec_slave[slave_index].outputs + module_index;
-
-  *(data_ptr++) = value.p.b0;
-  *data_ptr = value.p.b1;
+  PdoBuffer(nullptr, ec_slave[slave_index].outputs).write16(module_index, value);
 }
 
 void PdoInterfaceImpl::write32(uint16_t slave_index, uint8_t module_index, bit32 value)
 {
-  uint8_t* data_ptr = ec_slave[slave_index].outputs + module_index;
-
-  *(data_ptr++) = value.p.b0;
-  *(data_ptr++) = value.p.b1;
-  *(data_ptr++) = value.p.b2;
-  *data_ptr = value.p.b3;
+  PdoBuffer(nullptr, ec_slave[slave_index].outputs).write32(module_index, value);
 }
 
 bit8 PdoInterfaceImpl::read8(uint16_t slave_index, uint8_t module_index) const
 {
-  const uint8_t* data_ptr = ec_slave[slave_index].inputs + module_index;
-
-  bit8 return_value;
-  return_value.b0 = *data_ptr;
-
-  return return_value;
+  return PdoBuffer(ec_slave[slave_index].inputs, nullptr).read8(module_index);
 }
 
 bit16 PdoInterfaceImpl::read16(uint16_t slave_index, uint8_t module_index) const
 {
-  const uint8_t* data_ptr = ec_slave[slave_index].inputs + module_index;
-
-  bit16 result;
-  result.p.b0 = *(data_ptr++);
-  result.p.b1 = *data_ptr;
-
-  return result;
+  return PdoBuffer(ec_slave[slave_index].inputs, nullptr).read16(module_index);
 }
 
 bit32 PdoInterfaceImpl::read32(uint16_t slave_index, uint8_t module_index) const
 {
-  const uint8_t* data_ptr = ec_slave[slave_index].inputs + module_index;
+  return PdoBuffer(ec_slave[slave_index].inputs, nullptr).read32(module_index);
+}
 
-  bit32 return_value;
-  return_value.p.b0 = *(data_ptr++);
-  return_value.p.b1 = *(data_ptr++);
-  return_value.p.b2 = *(data_ptr++);
-  return_value.p.b3 = *data_ptr;
+const uint8_t* PdoInterfaceImpl::getInputs(uint16_t slave_index) const
+{
+  return ec_slave[slave_index].inputs;
+}
 
-  return return_value;
+uint8_t* PdoInterfaceImpl::getOutputs(uint16_t slave_index)
+{
+  return ec_slave[slave_index].outputs;
 }
 }  // namespace march
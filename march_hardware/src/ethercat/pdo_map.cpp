@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <map>
 #include <utility>
+#include <vector>
 
 namespace march
 {
@@ -30,6 +31,27 @@ std::unordered_map<IMCObjectName, IMCObject> PDOmap::all_objects = {
   { IMCObjectName::MotorVoltage, IMCObject(0x2108, 3, 16) }
 };
 
+IMCObjectOffsets::IMCObjectOffsets()
+{
+  this->offsets_.fill(0);
+  this->mapped_.fill(false);
+}
+
+IMCObjectOffsets::IMCObjectOffsets(const std::unordered_map<IMCObjectName, uint8_t>& byte_offsets) : IMCObjectOffsets()
+{
+  for (const auto& byte_offset : byte_offsets)
+  {
+    const size_t index = static_cast<size_t>(byte_offset.first);
+    this->offsets_[index] = byte_offset.second;
+    this->mapped_[index] = true;
+  }
+}
+
+bool IMCObjectOffsets::isMapped(IMCObjectName object_name) const
+{
+  return this->mapped_[static_cast<size_t>(object_name)];
+}
+
 void PDOmap::addObject(IMCObjectName object_name)
 {
   auto it = PDOmap::all_objects.find(object_name);
@@ -72,71 +94,130 @@ std::unordered_map<IMCObjectName, uint8_t> PDOmap::map(SdoSlaveInterface& sdo, D
 std::unordered_map<IMCObjectName, uint8_t> PDOmap::configurePDO(SdoSlaveInterface& sdo, int base_register,
                                                                 uint16_t base_sync_manager)
 {
-  int counter = 1;
-  int current_register = base_register;
   int size_left = this->bits_per_register;
 
   std::unordered_map<IMCObjectName, uint8_t> byte_offsets;
   std::vector<std::pair<IMCObjectName, IMCObject>> sorted_PDO_objects = this->sortPDOObjects();
 
-  sdo.write<uint8_t>(current_register, 0, 0);
+  // Combined addresses of the objects in every PDO register
+  std::vector<std::vector<uint32_t>> registers(1);
   for (const auto& next_object : sorted_PDO_objects)
   {
     if (size_left - next_object.second.length < 0)
     {
-      // PDO is filled so it can be enabled again
-      sdo.write<uint8_t>(current_register, 0, counter - 1);
-
-      // Update the sync manager with the just configured PDO
-      sdo.write<uint8_t>(base_sync_manager, 0, 0);
-      int current_pdo_nr = (current_register - base_register) + 1;
-      sdo.write<uint16_t>(base_sync_manager, current_pdo_nr, current_register);
-
-      // Move to the next PDO register by incrementing with one
-      current_register++;
-      if (current_register > (base_register + nr_of_regs))
+      // PDO is filled so move to the next PDO register
+      registers.emplace_back();
+      if (registers.size() > static_cast<size_t>(this->nr_of_regs))
       {
         ROS_ERROR("Amount of registers was overwritten, amount of parameters does not fit in the PDO messages.");
       }
-
       size_left = this->bits_per_register;
-      counter = 1;
-
-      sdo.write<uint8_t>(current_register, 0, 0);
     }
 
-    int byte_offset = (current_register - base_register) * 8 + (bits_per_register - size_left) / 8;
+    int byte_offset = (registers.size() - 1) * 8 + (bits_per_register - size_left) / 8;
     byte_offsets[next_object.first] = byte_offset;
 
-    sdo.write<uint32_t>(current_register, counter, next_object.second.combined_address);
-    counter++;
+    registers.back().push_back(next_object.second.combined_address);
     size_left -= next_object.second.length;
   }
 
-  // Make sure the last PDO is activated
-  sdo.write<uint8_t>(current_register, 0, counter - 1);
+  if (this->isMapped(sdo, registers, base_register, base_sync_manager))
+  {
+    ROS_DEBUG("PDO 0x%X is already mapped, skipping remapping", base_register);
+    return byte_offsets;
+  }
+
+  if (!this->writeCompleteAccess(sdo, registers, base_register, base_sync_manager))
+  {
+    ROS_DEBUG("Complete access rejected, writing PDO 0x%X entry by entry", base_register);
+    this->writePerEntry(sdo, registers, base_register, base_sync_manager);
+  }
+
+  return byte_offsets;
+}
+
+bool PDOmap::isMapped(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers, int base_register,
+                      uint16_t base_sync_manager)
+{
+  std::vector<uint16_t> assigned_registers;
+  if (sdo.readCompleteAccess<uint16_t>(base_sync_manager, assigned_registers) == 0 ||
+      assigned_registers.size() != registers.size())
+  {
+    return false;
+  }
+
+  for (size_t i = 0; i < registers.size(); i++)
+  {
+    const uint16_t current_register = base_register + i;
+    std::vector<uint32_t> mapped_objects;
+    if (assigned_registers[i] != current_register ||
+        sdo.readCompleteAccess<uint32_t>(current_register, mapped_objects) == 0 || mapped_objects != registers[i])
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
-  // Deactivated the sync manager and configure with the new PDO
-  sdo.write<uint8_t>(base_sync_manager, 0, 0);
-  int current_pdo_number = (current_register - base_register) + 1;
-  sdo.write<uint16_t>(base_sync_manager, current_pdo_number, current_register);
+bool PDOmap::writeCompleteAccess(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers,
+                                 int base_register, uint16_t base_sync_manager)
+{
+  std::vector<uint16_t> assigned_registers;
+  for (size_t i = 0; i < registers.size(); i++)
+  {
+    const uint16_t current_register = base_register + i;
+    if (sdo.writeCompleteAccess<uint32_t>(current_register, registers[i]) == 0)
+    {
+      return false;
+    }
+    assigned_registers.push_back(current_register);
+  }
 
   // Explicitly disable PDO registers which are not used
-  current_register++;
-  if (current_register < (base_register + nr_of_regs))
+  for (int unused_register = base_register + registers.size(); unused_register < (base_register + this->nr_of_regs);
+       unused_register++)
   {
-    for (int unused_register = current_register; unused_register < (base_register + this->nr_of_regs);
-         unused_register++)
+    if (sdo.writeCompleteAccess<uint32_t>(unused_register, {}) == 0)
     {
-      sdo.write<uint8_t>(unused_register, 0, 0);
+      return false;
     }
   }
 
-  // Activate the sync manager again
-  int total_pdos = (current_register - base_register);
-  sdo.write<uint8_t>(base_sync_manager, 0, total_pdos);
+  // Assigns the PDOs to the sync manager and activates it at once
+  return sdo.writeCompleteAccess<uint16_t>(base_sync_manager, assigned_registers) != 0;
+}
 
-  return byte_offsets;
+void PDOmap::writePerEntry(SdoSlaveInterface& sdo, const std::vector<std::vector<uint32_t>>& registers,
+                           int base_register, uint16_t base_sync_manager)
+{
+  for (size_t i = 0; i < registers.size(); i++)
+  {
+    const int current_register = base_register + i;
+    sdo.write<uint8_t>(current_register, 0, 0);
+    int counter = 1;
+    for (uint32_t combined_address : registers[i])
+    {
+      sdo.write<uint32_t>(current_register, counter, combined_address);
+      counter++;
+    }
+
+    // PDO is filled so it can be enabled again
+    sdo.write<uint8_t>(current_register, 0, counter - 1);
+
+    // Deactivate the sync manager and configure it with the just configured PDO
+    sdo.write<uint8_t>(base_sync_manager, 0, 0);
+    sdo.write<uint16_t>(base_sync_manager, i + 1, current_register);
+  }
+
+  // Explicitly disable PDO registers which are not used
+  for (int unused_register = base_register + registers.size(); unused_register < (base_register + this->nr_of_regs);
+       unused_register++)
+  {
+    sdo.write<uint8_t>(unused_register, 0, 0);
+  }
+
+  // Activate the sync manager again
+  sdo.write<uint8_t>(base_sync_manager, 0, registers.size());
 }
 
 std::vector<std::pair<IMCObjectName, IMCObject>> PDOmap::sortPDOObjects()
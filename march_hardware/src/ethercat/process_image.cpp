@@ -0,0 +1,173 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/process_image.h"
+
+#include <climits>
+#include <cstring>
+#include <utility>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace march
+{
+namespace
+{
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex requires a plain 32 bit word");
+
+void futexWait(std::atomic<uint32_t>& word, uint32_t expected)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, expected, nullptr, nullptr, 0);
+}
+
+void futexWakeAll(std::atomic<uint32_t>& word)
+{
+  syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+}  // namespace
+
+void ProcessImage::configure(std::vector<Range> outputs, std::vector<Range> inputs)
+{
+  this->outputs_ = std::move(outputs);
+  this->inputs_ = std::move(inputs);
+
+  const size_t inputs_size = ProcessImage::totalSize(this->inputs_);
+  for (InputSlot& slot : this->input_slots_)
+  {
+    slot.data.assign(inputs_size, 0);
+    slot.sequence = 0;
+  }
+  this->input_middle_ = 1;
+  this->input_back_ = 0;
+  this->input_front_ = 2;
+
+  const size_t outputs_size = ProcessImage::totalSize(this->outputs_);
+  for (std::vector<uint8_t>& slot : this->output_slots_)
+  {
+    slot.assign(outputs_size, 0);
+  }
+  this->output_middle_ = 1;
+  this->output_back_ = 0;
+  this->output_front_ = 2;
+  this->outputs_committed_ = false;
+
+  this->sequence_ = 0;
+  this->interrupted_ = false;
+}
+
+void ProcessImage::publishInputs(const uint8_t* io_map)
+{
+  InputSlot& slot = this->input_slots_[this->input_back_];
+  uint8_t* data = slot.data.data();
+  for (const Range& range : this->inputs_)
+  {
+    std::memcpy(data, io_map + range.offset, range.size);
+    data += range.size;
+  }
+  slot.sequence = this->sequence_.load(std::memory_order_relaxed) + 1;
+
+  const uint8_t previous = this->input_middle_.exchange(this->input_back_ | FRESH, std::memory_order_acq_rel);
+  this->input_back_ = previous & INDEX_MASK;
+
+  this->sequence_.store(slot.sequence);
+  this->wake();
+}
+
+void ProcessImage::fetchOutputs(uint8_t* io_map)
+{
+  if (this->output_middle_.load(std::memory_order_relaxed) & FRESH)
+  {
+    const uint8_t previous = this->output_middle_.exchange(this->output_front_, std::memory_order_acq_rel);
+    this->output_front_ = previous & INDEX_MASK;
+    this->outputs_committed_ = true;
+  }
+
+  if (this->outputs_committed_)
+  {
+    const uint8_t* data = this->output_slots_[this->output_front_].data();
+    for (const Range& range : this->outputs_)
+    {
+      std::memcpy(io_map + range.offset, data, range.size);
+      data += range.size;
+    }
+  }
+}
+
+void ProcessImage::commitOutputs(const uint8_t* image)
+{
+  uint8_t* data = this->output_slots_[this->output_back_].data();
+  for (const Range& range : this->outputs_)
+  {
+    std::memcpy(data, image + range.offset, range.size);
+    data += range.size;
+  }
+
+  const uint8_t previous = this->output_middle_.exchange(this->output_back_ | FRESH, std::memory_order_acq_rel);
+  this->output_back_ = previous & INDEX_MASK;
+}
+
+uint64_t ProcessImage::acquireInputs(uint8_t* image)
+{
+  if (this->input_middle_.load(std::memory_order_relaxed) & FRESH)
+  {
+    const uint8_t previous = this->input_middle_.exchange(this->input_front_, std::memory_order_acq_rel);
+    this->input_front_ = previous & INDEX_MASK;
+  }
+
+  const InputSlot& slot = this->input_slots_[this->input_front_];
+  const uint8_t* data = slot.data.data();
+  for (const Range& range : this->inputs_)
+  {
+    std::memcpy(image + range.offset, data, range.size);
+    data += range.size;
+  }
+  return slot.sequence;
+}
+
+bool ProcessImage::waitForInputs(uint64_t sequence)
+{
+  this->waiters_.fetch_add(1);
+  while (!this->interrupted_ && this->sequence_ == sequence)
+  {
+    const uint32_t word = this->futex_word_;
+    if (this->interrupted_ || this->sequence_ != sequence)
+    {
+      break;
+    }
+    futexWait(this->futex_word_, word);
+  }
+  this->waiters_.fetch_sub(1);
+  return !this->interrupted_;
+}
+
+void ProcessImage::interrupt()
+{
+  this->interrupted_ = true;
+  this->wake();
+}
+
+uint64_t ProcessImage::getSequence() const
+{
+  return this->sequence_;
+}
+
+size_t ProcessImage::totalSize(const std::vector<Range>& ranges)
+{
+  size_t size = 0;
+  for (const Range& range : ranges)
+  {
+    size += range.size;
+  }
+  return size;
+}
+
+void ProcessImage::wake()
+{
+  this->futex_word_.fetch_add(1);
+  // Only enter the kernel when the control thread is actually waiting
+  if (this->waiters_ > 0)
+  {
+    futexWakeAll(this->futex_word_);
+  }
+}
+}  // namespace march
@@ -18,6 +18,24 @@ int SdoInterfaceImpl::write(uint16_t slave, uint16_t index, uint8_t sub, std::si
   return working_counter;
 }
 
+int SdoInterfaceImpl::writeCompleteAccess(uint16_t slave, uint16_t index, std::size_t size, void* data)
+{
+  if (!(ec_slave[slave].CoEdetails & ECT_COEDET_SDOCA))
+  {
+    ROS_DEBUG("sdo_write_ca: slave %i does not support complete access", slave);
+    return 0;
+  }
+
+  ROS_DEBUG("sdo_write_ca: slave %i, reg 0x%X, %zu bytes", slave, index, size);
+  const int working_counter = ec_SDOwrite(slave, index, 0, TRUE, size, data, EC_TIMEOUTRXM);
+  if (working_counter == 0)
+  {
+    // Not fatal, since the caller can still write the entries one by one
+    ROS_WARN("sdo_write_ca: Error occurred when writing: slave %i, reg 0x%X", slave, index);
+  }
+  return working_counter;
+}
+
 int SdoInterfaceImpl::read(uint16_t slave, uint16_t index, uint8_t sub, int& val_size, void* value) const
 {
   ROS_DEBUG("sdo_read: slave %i, reg 0x%X, sub index %i", slave, index, sub);
@@ -28,4 +46,21 @@ int SdoInterfaceImpl::read(uint16_t slave, uint16_t index, uint8_t sub, int& val
   }
   return working_counter;
 }
+
+int SdoInterfaceImpl::readCompleteAccess(uint16_t slave, uint16_t index, int& size, void* data) const
+{
+  if (!(ec_slave[slave].CoEdetails & ECT_COEDET_SDOCA))
+  {
+    ROS_DEBUG("sdo_read_ca: slave %i does not support complete access", slave);
+    return 0;
+  }
+
+  ROS_DEBUG("sdo_read_ca: slave %i, reg 0x%X", slave, index);
+  const int working_counter = ec_SDOread(slave, index, 0, TRUE, &size, data, EC_TIMEOUTRXM);
+  if (working_counter == 0)
+  {
+    ROS_WARN("sdo_read_ca: Error occurred when reading: slave %i, reg 0x%X", slave, index);
+  }
+  return working_counter;
+}
 }  // namespace march
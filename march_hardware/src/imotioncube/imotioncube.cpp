@@ -2,9 +2,12 @@
 #include "march_hardware/imotioncube/imotioncube.h"
 #include "march_hardware/error/hardware_exception.h"
 #include "march_hardware/error/motion_error.h"
+#include "march_hardware/ethercat/pdo_buffer.h"
 #include "march_hardware/ethercat/pdo_types.h"
 
+#include <algorithm>
 #include <bitset>
+#include <chrono>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -17,10 +20,17 @@ namespace march
 {
 IMotionCube::IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> absolute_encoder,
                          std::unique_ptr<IncrementalEncoder> incremental_encoder, ActuationMode actuation_mode)
+  : IMotionCube(slave, std::move(absolute_encoder), std::move(incremental_encoder), nullptr, actuation_mode)
+{
+}
+
+IMotionCube::IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> absolute_encoder,
+                         std::unique_ptr<IncrementalEncoder> incremental_encoder, SetupImagePtr setup,
+                         ActuationMode actuation_mode)
   : Slave(slave)
   , absolute_encoder_(std::move(absolute_encoder))
   , incremental_encoder_(std::move(incremental_encoder))
-  , sw_string_("empty")
+  , setup_(std::move(setup))
   , actuation_mode_(actuation_mode)
 {
   if (!this->absolute_encoder_ || !this->incremental_encoder_)
@@ -29,14 +39,6 @@ IMotionCube::IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> ab
   }
 }
 
-IMotionCube::IMotionCube(const Slave& slave, std::unique_ptr<AbsoluteEncoder> absolute_encoder,
-                         std::unique_ptr<IncrementalEncoder> incremental_encoder, std::string& sw_stream,
-                         ActuationMode actuation_mode)
-  : IMotionCube(slave, std::move(absolute_encoder), std::move(incremental_encoder), actuation_mode)
-{
-  this->sw_string_ = std::move(sw_stream);
-}
-
 bool IMotionCube::initSdo(SdoSlaveInterface& sdo, int cycle_time)
 {
   if (this->actuation_mode_ == ActuationMode::unknown)
@@ -51,6 +53,12 @@ bool IMotionCube::initSdo(SdoSlaveInterface& sdo, int cycle_time)
   return this->writeInitialSettings(sdo, cycle_time);
 }
 
+uint16_t IMotionCube::getWatchdogTime(int cycle_time_us)
+{
+  const int watchdog_time = cycle_time_us / 8;
+  return std::min<int>(std::max<int>(watchdog_time, IMotionCube::WATCHDOG_MIN_TIME), UINT16_MAX);
+}
+
 // Map Process Data Object (PDO) for by sending SDOs to the IMC
 // Master In, Slave Out
 void IMotionCube::mapMisoPDOs(SdoSlaveInterface& sdo)
@@ -67,7 +75,7 @@ void IMotionCube::mapMisoPDOs(SdoSlaveInterface& sdo)
   map_miso.addObject(IMCObjectName::MotorPosition);
   map_miso.addObject(IMCObjectName::MotorVelocity);
   map_miso.addObject(IMCObjectName::ActualVelocity);
-  this->miso_byte_offsets_ = map_miso.map(sdo, DataDirection::MISO);
+  this->miso_byte_offsets_ = IMCObjectOffsets(map_miso.map(sdo, DataDirection::MISO));
 }
 
 // Map Process Data Object (PDO) for by sending SDOs to the IMC
@@ -78,7 +86,7 @@ void IMotionCube::mapMosiPDOs(SdoSlaveInterface& sdo)
   map_mosi.addObject(IMCObjectName::ControlWord);  // Compulsory!
   map_mosi.addObject(IMCObjectName::TargetPosition);
   map_mosi.addObject(IMCObjectName::TargetTorque);
-  this->mosi_byte_offsets_ = map_mosi.map(sdo, DataDirection::MOSI);
+  this->mosi_byte_offsets_ = IMCObjectOffsets(map_mosi.map(sdo, DataDirection::MOSI));
 }
 
 // Set configuration parameters to the IMC
@@ -126,9 +134,23 @@ bool IMotionCube::writeInitialSettings(SdoSlaveInterface& sdo, int cycle_time)
   // Abort connection option code
   int abort_con = sdo.write<int16_t>(0x6007, 0, 1);
 
-  // set the ethercat rate of encoder in form x*10^y
-  int rate_ec_x = sdo.write<uint8_t>(0x60C2, 1, cycle_time);
-  int rate_ec_y = sdo.write<int8_t>(0x60C2, 2, -3);
+  // set the ethercat rate of encoder in form x*10^y, where x must fit in a single byte
+  int rate_x = cycle_time;
+  int rate_y = -6;
+  while (rate_x > UINT8_MAX && rate_x % 10 == 0)
+  {
+    rate_x /= 10;
+    rate_y++;
+  }
+  if (rate_x <= 0 || rate_x > UINT8_MAX)
+  {
+    throw error::HardwareException(error::ErrorType::WRITING_INITIAL_SETTINGS_FAILED,
+                                   "Cycle time of %d us cannot be written as interpolation time period of IMC of "
+                                   "slave %d",
+                                   cycle_time, this->getSlaveIndex());
+  }
+  int rate_ec_x = sdo.write<uint8_t>(0x60C2, 1, rate_x);
+  int rate_ec_y = sdo.write<int8_t>(0x60C2, 2, rate_y);
 
   // use filter object to read motor voltage
   int volt_address = sdo.write<int16_t>(0x2108, 1, 0x0232);
@@ -171,11 +193,7 @@ void IMotionCube::actuateIU(int32_t target_iu)
                                    this->absolute_encoder_->getUpperSoftLimitIU());
   }
 
-  bit32 target_position = { .i = target_iu };
-
-  uint8_t target_position_location = this->mosi_byte_offsets_.at(IMCObjectName::TargetPosition);
-
-  this->write32(target_position_location, target_position);
+  this->outputs_.target_position = target_iu;
 }
 
 void IMotionCube::actuateTorque(int16_t target_torque)
@@ -193,31 +211,63 @@ void IMotionCube::actuateTorque(int16_t target_torque)
                                    "Target torque of %d exceeds max torque of %d", target_torque, MAX_TARGET_TORQUE);
   }
 
-  bit16 target_torque_struct = { .i = target_torque };
+  this->outputs_.target_torque = target_torque;
+}
 
-  uint8_t target_torque_location = this->mosi_byte_offsets_.at(IMCObjectName::TargetTorque);
+void IMotionCube::readInputs()
+{
+  const PdoBuffer buffer = this->getPdoBuffer();
+  if (buffer.hasInputs())
+  {
+    this->decodeInputs(buffer);
+  }
+  else
+  {
+    this->decodeInputs<PdoSlaveInterface>(*this);
+  }
+}
 
-  this->write16(target_torque_location, target_torque_struct);
+template <typename Pdo>
+void IMotionCube::decodeInputs(const Pdo& pdo)
+{
+  IMotionCubeInputs& inputs = this->inputs_;
+  const IMCObjectOffsets& offsets = this->miso_byte_offsets_;
+  inputs.status_word = pdo.read16(offsets[IMCObjectName::StatusWord]).ui;
+  inputs.motion_error = pdo.read16(offsets[IMCObjectName::MotionErrorRegister]).ui;
+  inputs.detailed_error = pdo.read16(offsets[IMCObjectName::DetailedErrorRegister]).ui;
+  inputs.second_detailed_error = pdo.read16(offsets[IMCObjectName::SecondDetailedErrorRegister]).ui;
+  inputs.absolute_position = pdo.read32(offsets[IMCObjectName::ActualPosition]).i;
+  inputs.absolute_velocity = pdo.read32(offsets[IMCObjectName::ActualVelocity]).i;
+  inputs.incremental_position = pdo.read32(offsets[IMCObjectName::MotorPosition]).i;
+  inputs.incremental_velocity = pdo.read32(offsets[IMCObjectName::MotorVelocity]).i;
+  inputs.torque = pdo.read16(offsets[IMCObjectName::ActualTorque]).i;
+  inputs.dc_link_voltage = pdo.read16(offsets[IMCObjectName::DCLinkVoltage]).ui;
+  inputs.motor_voltage = pdo.read16(offsets[IMCObjectName::MotorVoltage]).ui;
+}
+
+const IMotionCubeInputs& IMotionCube::getInputs() const
+{
+  return this->inputs_;
 }
 
 double IMotionCube::getAngleRadAbsolute()
 {
-  if (!IMotionCubeTargetState::SWITCHED_ON.isReached(this->getStatusWord()) &&
-      !IMotionCubeTargetState::OPERATION_ENABLED.isReached(this->getStatusWord()))
+  if (!IMotionCubeTargetState::SWITCHED_ON.isReached(this->inputs_.status_word) &&
+      !IMotionCubeTargetState::OPERATION_ENABLED.isReached(this->inputs_.status_word))
   {
     ROS_WARN_THROTTLE(10, "Invalid use of encoders, you're not in the correct state.");
   }
-  return this->absolute_encoder_->getAngleRad(*this, this->miso_byte_offsets_.at(IMCObjectName::ActualPosition));
+  return this->absolute_encoder_->toRad(this->inputs_.absolute_position);
 }
 
 double IMotionCube::getAngleRadIncremental()
 {
-  if (!IMotionCubeTargetState::SWITCHED_ON.isReached(this->getStatusWord()) &&
-      !IMotionCubeTargetState::OPERATION_ENABLED.isReached(this->getStatusWord()))
+  if (!IMotionCubeTargetState::SWITCHED_ON.isReached(this->inputs_.status_word) &&
+      !IMotionCubeTargetState::OPERATION_ENABLED.isReached(this->inputs_.status_word))
   {
     ROS_WARN_THROTTLE(10, "Invalid use of encoders, you're not in the correct state.");
   }
-  return this->incremental_encoder_->getAngleRad(*this, this->miso_byte_offsets_.at(IMCObjectName::MotorPosition));
+  return this->incremental_encoder_->toRad(this->inputs_.incremental_position);
 }
 
 double IMotionCube::getAbsoluteRadPerBit() const
@@ -232,133 +282,213 @@ double IMotionCube::getIncrementalRadPerBit() const
 
 int16_t IMotionCube::getTorque()
 {
-  bit16 return_byte = this->read16(this->miso_byte_offsets_.at(IMCObjectName::ActualTorque));
-  return return_byte.i;
+  return this->inputs_.torque;
 }
 
 int32_t IMotionCube::getAngleIUAbsolute()
 {
-  return this->absolute_encoder_->getAngleIU(*this, this->miso_byte_offsets_.at(IMCObjectName::ActualPosition));
+  return this->inputs_.absolute_position;
 }
 
 int IMotionCube::getAngleIUIncremental()
 {
-  return this->incremental_encoder_->getAngleIU(*this, this->miso_byte_offsets_.at(IMCObjectName::MotorPosition));
+  return this->inputs_.incremental_position;
 }
 
 double IMotionCube::getVelocityIUAbsolute()
 {
-  return this->absolute_encoder_->getVelocityIU(*this, this->miso_byte_offsets_.at(IMCObjectName::ActualVelocity));
+  return Encoder::toVelocityIU(this->inputs_.absolute_velocity);
 }
 
 double IMotionCube::getVelocityIUIncremental()
 {
-  return this->incremental_encoder_->getVelocityIU(*this, this->miso_byte_offsets_.at(IMCObjectName::MotorVelocity));
+  return Encoder::toVelocityIU(this->inputs_.incremental_velocity);
 }
 
 double IMotionCube::getVelocityRadAbsolute()
 {
-  return this->absolute_encoder_->getVelocityRad(*this, this->miso_byte_offsets_.at(IMCObjectName::ActualVelocity));
+  return this->absolute_encoder_->toVelocityRad(this->inputs_.absolute_velocity);
 }
 
 double IMotionCube::getVelocityRadIncremental()
 {
-  return this->incremental_encoder_->getVelocityRad(*this, this->miso_byte_offsets_.at(IMCObjectName::MotorVelocity));
+  return this->incremental_encoder_->toVelocityRad(this->inputs_.incremental_velocity);
 }
 
 uint16_t IMotionCube::getStatusWord()
 {
-  return this->read16(this->miso_byte_offsets_.at(IMCObjectName::StatusWord)).ui;
+  return this->inputs_.status_word;
 }
 
 uint16_t IMotionCube::getMotionError()
 {
-  return this->read16(this->miso_byte_offsets_.at(IMCObjectName::MotionErrorRegister)).ui;
+  return this->inputs_.motion_error;
 }
 
 uint16_t IMotionCube::getDetailedError()
 {
-  return this->read16(this->miso_byte_offsets_.at(IMCObjectName::DetailedErrorRegister)).ui;
+  return this->inputs_.detailed_error;
 }
 
 uint16_t IMotionCube::getSecondDetailedError()
 {
-  return this->read16(this->miso_byte_offsets_.at(IMCObjectName::SecondDetailedErrorRegister)).ui;
+  return this->inputs_.second_detailed_error;
 }
 
 float IMotionCube::getMotorCurrent()
 {
-  const float PEAK_CURRENT = 40.0;            // Peak current of iMC drive
-  const float IU_CONVERSION_CONST = 65520.0;  // Conversion parameter, see Technosoft CoE programming manual
-
-  int16_t motor_current_iu = this->read16(this->miso_byte_offsets_.at(IMCObjectName::ActualTorque)).i;
+  const int16_t motor_current_iu = this->inputs_.torque;
   return (2.0f * PEAK_CURRENT / IU_CONVERSION_CONST) *
          static_cast<float>(motor_current_iu);  // Conversion to Amp, see Technosoft CoE programming manual
 }
 
 float IMotionCube::getIMCVoltage()
 {
-  // maximum measurable DC voltage found in EMS Setup/Drive info button
-  const float V_DC_MAX_MEASURABLE = 102.3;
-  // Conversion parameter, see Technosoft CoE programming manual (2015 page 89)
-  const float IU_CONVERSION_CONST = 65520.0;
-
-  uint16_t imc_voltage_iu = this->read16(this->miso_byte_offsets_.at(IMCObjectName::DCLinkVoltage)).ui;
+  const uint16_t imc_voltage_iu = this->inputs_.dc_link_voltage;
   return (V_DC_MAX_MEASURABLE / IU_CONVERSION_CONST) *
          static_cast<float>(imc_voltage_iu);  // Conversion to Volt, see Technosoft CoE programming manual
 }
 
 float IMotionCube::getMotorVoltage()
 {
-  return this->read16(this->miso_byte_offsets_.at(IMCObjectName::MotorVoltage)).ui;
+  return this->inputs_.motor_voltage;
 }
 
 void IMotionCube::setControlWord(uint16_t control_word)
 {
-  bit16 control_word_ui = { .ui = control_word };
-  this->write16(this->mosi_byte_offsets_.at(IMCObjectName::ControlWord), control_word_ui);
+  this->outputs_.control_word = control_word;
 }
 
-void IMotionCube::goToTargetState(IMotionCubeTargetState target_state)
+void IMotionCube::configureState(RobotState& state, size_t joint) const
 {
-  ROS_DEBUG("\tTry to go to '%s'", target_state.getDescription().c_str());
-  while (!target_state.isReached(this->getStatusWord()))
+  using Quantity = RobotState::Quantity;
+  const AbsoluteEncoder& absolute = *this->absolute_encoder_;
+  const IncrementalEncoder& incremental = *this->incremental_encoder_;
+  state.setConversion(Quantity::AbsolutePosition, joint, absolute.getRadPerBit(), absolute.getZeroPositionIU());
+  state.setConversion(Quantity::IncrementalPosition, joint, incremental.getRadPerBit(),
+                      incremental.getZeroPositionIU());
+  state.setConversion(Quantity::AbsoluteVelocity, joint, absolute.getRadPerSecondPerVelocity());
+  state.setConversion(Quantity::IncrementalVelocity, joint, incremental.getRadPerSecondPerVelocity());
+  state.setConversion(Quantity::MotorCurrent, joint, 2.0f * PEAK_CURRENT / IU_CONVERSION_CONST);
+  state.setConversion(Quantity::IMCVoltage, joint, V_DC_MAX_MEASURABLE / IU_CONVERSION_CONST);
+  state.setConversion(Quantity::MotorVoltage, joint, 1.0);
+  state.setConversion(Quantity::Effort, joint, 1.0);
+}
+
+void IMotionCube::storeState(RobotState& state, size_t joint) const
+{
+  using Quantity = RobotState::Quantity;
+  using Register = RobotState::Register;
+  const IMotionCubeInputs& inputs = this->inputs_;
+  state.setRegister(Register::StatusWord, joint, inputs.status_word);
+  state.setRegister(Register::MotionError, joint, inputs.motion_error);
+  state.setRegister(Register::DetailedError, joint, inputs.detailed_error);
+  state.setRegister(Register::SecondDetailedError, joint, inputs.second_detailed_error);
+  state.setIU(Quantity::AbsolutePosition, joint, inputs.absolute_position);
+  state.setIU(Quantity::IncrementalPosition, joint, inputs.incremental_position);
+  state.setIU(Quantity::AbsoluteVelocity, joint, inputs.absolute_velocity);
+  state.setIU(Quantity::IncrementalVelocity, joint, inputs.incremental_velocity);
+  state.setIU(Quantity::MotorCurrent, joint, inputs.torque);
+  state.setIU(Quantity::IMCVoltage, joint, inputs.dc_link_voltage);
+  state.setIU(Quantity::MotorVoltage, joint, inputs.motor_voltage);
+  state.setIU(Quantity::Effort, joint, inputs.torque);
+}
+
+void IMotionCube::writeOutputs()
+{
+  // The outputs are only mapped once the drive is initialized
+  if (!this->mosi_byte_offsets_.isMapped(IMCObjectName::ControlWord))
   {
-    this->setControlWord(target_state.getControlWord());
-    ROS_INFO_DELAYED_THROTTLE(5, "\tWaiting for '%s': %s", target_state.getDescription().c_str(),
-                              std::bitset<16>(this->getStatusWord()).to_string().c_str());
-    if (target_state.getState() == IMotionCubeTargetState::OPERATION_ENABLED.getState() &&
-        IMCState(this->getStatusWord()) == IMCState::FAULT)
-    {
-      ROS_FATAL("IMotionCube went to fault state while attempting to go to '%s'. Shutting down.",
-                target_state.getDescription().c_str());
-      ROS_FATAL("Motion Error (MER): %s",
-                error::parseError(this->getMotionError(), error::ErrorRegisters::MOTION_ERROR).c_str());
-      ROS_FATAL("Detailed Error (DER): %s",
-                error::parseError(this->getDetailedError(), error::ErrorRegisters::DETAILED_ERROR).c_str());
-      ROS_FATAL(
-          "Detailed Error 2 (DER2): %s",
-          error::parseError(this->getSecondDetailedError(), error::ErrorRegisters::SECOND_DETAILED_ERROR).c_str());
-
-      throw std::domain_error("IMC to fault state");
-    }
+    return;
+  }
+  PdoBuffer buffer = this->getPdoBuffer();
+  if (buffer.hasOutputs())
+  {
+    this->encodeOutputs(buffer);
   }
-  ROS_DEBUG("\tReached '%s'!", target_state.getDescription().c_str());
+  else
+  {
+    this->encodeOutputs<PdoSlaveInterface>(*this);
+  }
+}
+
+template <typename Pdo>
+void IMotionCube::encodeOutputs(Pdo& pdo) const
+{
+  const IMCObjectOffsets& offsets = this->mosi_byte_offsets_;
+  const bit16 control_word = { .ui = this->outputs_.control_word };
+  const bit32 target_position = { .i = this->outputs_.target_position };
+  const bit16 target_torque = { .i = this->outputs_.target_torque };
+  pdo.write16(offsets[IMCObjectName::ControlWord], control_word);
+  pdo.write32(offsets[IMCObjectName::TargetPosition], target_position);
+  pdo.write16(offsets[IMCObjectName::TargetTorque], target_torque);
 }
 
-void IMotionCube::goToOperationEnabled()
+const IMotionCubeOutputs& IMotionCube::getOutputs() const
 {
+  return this->outputs_;
+}
+
+bool IMotionCube::stepToOperationEnabled()
+{
+  // The CiA402 transitions from any state, including fault, to operation enabled
+  static const IMotionCubeTargetState* const ENABLE_SEQUENCE[] = {
+    &IMotionCubeTargetState::SWITCH_ON_DISABLED, &IMotionCubeTargetState::READY_TO_SWITCH_ON,
+    &IMotionCubeTargetState::SWITCHED_ON, &IMotionCubeTargetState::OPERATION_ENABLED
+  };
+  const size_t enable_steps = sizeof(ENABLE_SEQUENCE) / sizeof(ENABLE_SEQUENCE[0]);
+
   if (this->actuation_mode_ == ActuationMode::unknown)
   {
     throw error::HardwareException(error::ErrorType::INVALID_ACTUATION_MODE, "Trying to go to operation enabled with "
                                                                              "unknown actuation mode");
   }
-  this->setControlWord(128);
 
-  this->goToTargetState(IMotionCubeTargetState::SWITCH_ON_DISABLED);
-  this->goToTargetState(IMotionCubeTargetState::READY_TO_SWITCH_ON);
-  this->goToTargetState(IMotionCubeTargetState::SWITCHED_ON);
+  const IMotionCubeTargetState& target_state = *ENABLE_SEQUENCE[this->enable_step_];
+  const uint16_t status_word = this->getStatusWord();
+  // The first transition resets a fault, after that a fault is caused by enabling the drive
+  if (this->enable_step_ > 0 && IMCState(status_word) == IMCState::FAULT)
+  {
+    this->enable_step_ = 0;
+    this->logFault(target_state);
+    throw std::domain_error("IMC to fault state");
+  }
+
+  if (!target_state.isReached(status_word))
+  {
+    this->setControlWord(target_state.getControlWord());
+    ROS_INFO_DELAYED_THROTTLE(5, "\tSlave %d waiting for '%s': %s", this->getSlaveIndex(),
+                              target_state.getDescription().c_str(), std::bitset<16>(status_word).to_string().c_str());
+    return false;
+  }
+  ROS_DEBUG("\tSlave %d reached '%s'!", this->getSlaveIndex(), target_state.getDescription().c_str());
+
+  this->enable_step_++;
+  if (this->enable_step_ == enable_steps)
+  {
+    this->enable_step_ = 0;
+    return true;
+  }
+
+  if (&target_state == &IMotionCubeTargetState::SWITCHED_ON)
+  {
+    try
+    {
+      this->actuateCurrentPosition();
+    }
+    catch (...)
+    {
+      this->enable_step_ = 0;
+      throw;
+    }
+  }
+  // Request the next transition right away, so it is sent in the same cycle
+  this->setControlWord(ENABLE_SEQUENCE[this->enable_step_]->getControlWord());
+  return false;
+}
 
+void IMotionCube::actuateCurrentPosition()
+{
   const int32_t angle = this->getAngleIUAbsolute();
   //  If the encoder is functioning correctly and the joint is not outside hardlimits, move the joint to its current
   //  position. Otherwise shutdown
@@ -385,51 +515,39 @@ void IMotionCube::goToOperationEnabled()
   {
     this->actuateTorque(0);
   }
+}
 
-  this->goToTargetState(IMotionCubeTargetState::OPERATION_ENABLED);
+void IMotionCube::logFault(const IMotionCubeTargetState& target_state)
+{
+  ROS_FATAL("IMotionCube with slave index %d went to fault state while attempting to go to '%s'. Shutting down.",
+            this->getSlaveIndex(), target_state.getDescription().c_str());
+  ROS_FATAL("Motion Error (MER): %s",
+            error::parseError(this->getMotionError(), error::ErrorRegisters::MOTION_ERROR).c_str());
+  ROS_FATAL("Detailed Error (DER): %s",
+            error::parseError(this->getDetailedError(), error::ErrorRegisters::DETAILED_ERROR).c_str());
+  ROS_FATAL("Detailed Error 2 (DER2): %s",
+            error::parseError(this->getSecondDetailedError(), error::ErrorRegisters::SECOND_DETAILED_ERROR).c_str());
 }
 
 void IMotionCube::reset(SdoSlaveInterface& sdo)
 {
   this->setControlWord(0);
+  this->writeOutputs();
   ROS_DEBUG("Slave: %d, Try to reset IMC", this->getSlaveIndex());
   sdo.write<uint16_t>(0x2080, 0, 1);
 }
 
-uint16_t IMotionCube::computeSWCheckSum(uint16_t& start_address, uint16_t& end_address)
+bool IMotionCube::verifySetup(SdoSlaveInterface& sdo)
 {
-  size_t pos = 0;
-  size_t old_pos = 0;
-  uint16_t sum = 0;
-  const std::string delimiter = "\n";
-  while ((pos = sw_string_.find(delimiter, old_pos)) != std::string::npos)
+  if (!this->setup_)
   {
-    std::string token = sw_string_.substr(old_pos, pos - old_pos);
-    if (old_pos == 0)
-    {
-      start_address = std::stoi(token, nullptr, 16);
-      token = "0";
-    }
-    if (pos == old_pos)
-    {
-      end_address = end_address + start_address - 1;  // The -1 compensates the offset of the end_address
-      return sum;
-    }
-    end_address++;
-    sum += std::stoi(token, nullptr, 16);  // State that we are looking at hexadecimal numbers
-    old_pos = pos + delimiter.length();    // Make sure to check the position after the previous one
+    throw error::HardwareException(error::ErrorType::INVALID_SW_STRING, "No .sw file setup for slave %d",
+                                   this->getSlaveIndex());
   }
-  throw error::HardwareException(error::ErrorType::INVALID_SW_STRING, "The .sw file has no delimiter of type %s",
-                                 delimiter.c_str());
-}
 
-bool IMotionCube::verifySetup(SdoSlaveInterface& sdo)
-{
-  uint16_t start_address = 0;
-  uint16_t end_address = 0;
-  const uint32_t sw_value = this->computeSWCheckSum(start_address, end_address);
   // set parameters to compute checksum on the imc
-  const int checksum_setup = sdo.write<uint32_t>(0x2069, 0, (end_address << 16) | start_address);
+  const int checksum_setup =
+      sdo.write<uint32_t>(0x2069, 0, (this->setup_->getEndAddress() << 16) | this->setup_->getStartAddress());
 
   uint16_t imc_value;
   int value_size = sizeof(imc_value);
@@ -441,60 +559,47 @@ bool IMotionCube::verifySetup(SdoSlaveInterface& sdo)
                                    "Failed checking the checksum on slave: %d", this->getSlaveIndex());
   }
 
-  ROS_DEBUG("The .sw checksum is : %d, and the drive checksum is %d", sw_value, imc_value);
-  return sw_value == imc_value;
+  ROS_DEBUG("The .sw checksum is : %d, and the drive checksum is %d", this->setup_->getChecksum(), imc_value);
+  return this->setup_->getChecksum() == imc_value;
 }
 
 void IMotionCube::downloadSetupToDrive(SdoSlaveInterface& sdo)
 {
-  int result = 0;
-  int final_result = 0;
+  const std::vector<uint16_t>& words = this->setup_->getWords();
+  const auto start_time = std::chrono::steady_clock::now();
+  ROS_INFO("Slave %d: downloading %zu words of setup", this->getSlaveIndex(), words.size());
 
-  size_t pos = 0;
-  size_t old_pos = 0;
-  const std::string delimiter = "\n";
-  while ((pos = sw_string_.find(delimiter, old_pos)) != std::string::npos)
+  const uint16_t mem_setup = 9;  // send 16-bits and auto increment
+  // write the write-configuration
+  int final_result = sdo.write<uint32_t>(0x2064, 0, (this->setup_->getStartAddress() << 16) | mem_setup);
+
+  int reported_percentage = 0;
+  for (size_t i = 0; i < words.size(); i += 2)
   {
-    const std::string token = sw_string_.substr(old_pos, pos - old_pos);
-    if (old_pos == 0)
+    // Two words are written at once, the last word on its own when the amount of words is odd
+    uint32_t data = words[i];
+    if (i + 1 < words.size())
     {
-      const uint16_t mem_location = std::stoi(token, nullptr, 16);
-      const uint16_t mem_setup = 9;                                               // send 16-bits and auto increment
-      result = sdo.write<uint32_t>(0x2064, 0, (mem_location << 16) | mem_setup);  // write the write-configuration
-      final_result |= result;
+      data |= static_cast<uint32_t>(words[i + 1]) << 16;
     }
-    else
+    final_result &= sdo.write<uint32_t>(0x2065, 0, data);
+
+    const int percentage = std::min<int>(100 * (i + 2) / words.size(), 100);
+    if (percentage >= reported_percentage + SETUP_PROGRESS_STEP)
     {
-      if (pos == old_pos)
-      {
-        break;
-      }
-      else
-      {
-        old_pos = pos + delimiter.length();
-        pos = sw_string_.find(delimiter, old_pos);
-        const std::string next_token = sw_string_.substr(old_pos, pos - old_pos);
-
-        uint32_t data = 0;
-        if (pos != old_pos)
-        {
-          data = (std::stoi(next_token, nullptr, 16) << 16) | std::stoi(token, nullptr, 16);
-        }
-        else
-        {
-          data = std::stoi(token, nullptr, 16);
-        }
-        result = sdo.write<uint32_t>(0x2065, 0, data);  // write the write-configuration
-      }
+      reported_percentage = percentage - percentage % SETUP_PROGRESS_STEP;
+      ROS_INFO("Slave %d: downloaded %d%% of setup", this->getSlaveIndex(), reported_percentage);
     }
-    final_result &= result;
-    old_pos = pos + delimiter.length();  // Make sure to check the position after the previous one
   }
+
   if (final_result == 0)
   {
     throw error::HardwareException(error::ErrorType::WRITING_INITIAL_SETTINGS_FAILED,
                                    "Failed writing .sw file to IMC of slave %d", this->getSlaveIndex());
   }
+
+  const std::chrono::duration<double> duration = std::chrono::steady_clock::now() - start_time;
+  ROS_INFO("Slave %d: downloaded setup in %.3f s", this->getSlaveIndex(), duration.count());
 }
 
 ActuationMode IMotionCube::getActuationMode() const
@@ -0,0 +1,118 @@
+// Copyright 2020 Project March.
+#include "march_hardware/imotioncube/setup_image.h"
+#include "march_hardware/error/hardware_exception.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace march
+{
+namespace
+{
+int hexValue(int character)
+{
+  if (character >= '0' && character <= '9')
+  {
+    return character - '0';
+  }
+  if (character >= 'a' && character <= 'f')
+  {
+    return character - 'a' + 10;
+  }
+  if (character >= 'A' && character <= 'F')
+  {
+    return character - 'A' + 10;
+  }
+  return -1;
+}
+}  // namespace
+
+SetupImage::SetupImage(uint16_t start_address, std::vector<uint16_t> words)
+  : start_address_(start_address), words_(std::move(words))
+{
+  for (uint16_t word : this->words_)
+  {
+    this->checksum_ += word;
+  }
+}
+
+SetupImage SetupImage::parse(std::istream& sw)
+{
+  std::streambuf* buffer = sw.rdbuf();
+  if (buffer == nullptr)
+  {
+    throw error::HardwareException(error::ErrorType::INVALID_SW_STRING, "The .sw file cannot be read");
+  }
+
+  bool has_start_address = false;
+  uint16_t start_address = 0;
+  std::vector<uint16_t> words;
+  uint16_t value = 0;
+  int digits = 0;
+  size_t line = 1;
+  for (int character = buffer->sbumpc(); character != std::char_traits<char>::eof(); character = buffer->sbumpc())
+  {
+    if (character == '\r')
+    {
+      continue;
+    }
+    if (character == '\n')
+    {
+      if (digits == 0)
+      {
+        if (!has_start_address)
+        {
+          throw error::HardwareException(error::ErrorType::INVALID_SW_STRING, "The .sw file has no start address");
+        }
+        return SetupImage(start_address, std::move(words));
+      }
+
+      if (has_start_address)
+      {
+        words.push_back(value);
+      }
+      else
+      {
+        start_address = value;
+        has_start_address = true;
+      }
+      value = 0;
+      digits = 0;
+      line++;
+      continue;
+    }
+
+    const int digit = hexValue(character);
+    if (digit < 0 || digits == 4)
+    {
+      throw error::HardwareException(error::ErrorType::INVALID_SW_STRING,
+                                     "The .sw file has no 16 bit hexadecimal word on line %zu", line);
+    }
+    value = (value << 4) | digit;
+    digits++;
+  }
+  throw error::HardwareException(error::ErrorType::INVALID_SW_STRING,
+                                 "The .sw file has no empty line ending the setup");
+}
+
+uint16_t SetupImage::getStartAddress() const
+{
+  return this->start_address_;
+}
+
+uint16_t SetupImage::getEndAddress() const
+{
+  return this->start_address_ + this->words_.size();
+}
+
+uint16_t SetupImage::getChecksum() const
+{
+  return this->checksum_;
+}
+
+const std::vector<uint16_t>& SetupImage::getWords() const
+{
+  return this->words_;
+}
+}  // namespace march
@@ -0,0 +1,34 @@
+// Copyright 2020 Project March.
+#include "march_hardware/iu_conversion.h"
+
+#if defined(__AVX__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace march
+{
+void convertIU(const int32_t* iu, const double* offset, const double* scale, double* si, size_t count)
+{
+  size_t i = 0;
+#if defined(__AVX__)
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m256d values = _mm256_cvtepi32_pd(_mm_loadu_si128(reinterpret_cast<const __m128i*>(iu + i)));
+    const __m256d shifted = _mm256_sub_pd(values, _mm256_loadu_pd(offset + i));
+    _mm256_storeu_pd(si + i, _mm256_mul_pd(shifted, _mm256_loadu_pd(scale + i)));
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 2 <= count; i += 2)
+  {
+    const __m128d values = _mm_cvtepi32_pd(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(iu + i)));
+    const __m128d shifted = _mm_sub_pd(values, _mm_loadu_pd(offset + i));
+    _mm_storeu_pd(si + i, _mm_mul_pd(shifted, _mm_loadu_pd(scale + i)));
+  }
+#endif
+  for (; i < count; i++)
+  {
+    si[i] = (iu[i] - offset[i]) * scale[i];
+  }
+}
+}  // namespace march
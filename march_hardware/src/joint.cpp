@@ -19,7 +19,11 @@ Joint::Joint(std::string name, int net_number) : name_(std::move(name)), net_num
 }
 
 Joint::Joint(std::string name, int net_number, bool allow_actuation, std::unique_ptr<IMotionCube> imc)
-  : name_(std::move(name)), net_number_(net_number), allow_actuation_(allow_actuation), imc_(std::move(imc))
+  : name_(std::move(name))
+  , net_number_(net_number)
+  , allow_actuation_(allow_actuation)
+  , imc_(std::move(imc))
+  , use_incremental_encoder_(Joint::usesIncrementalEncoder(this->imc_.get()))
 {
 }
 
@@ -30,6 +34,7 @@ Joint::Joint(std::string name, int net_number, bool allow_actuation, std::unique
   , allow_actuation_(allow_actuation)
   , imc_(std::move(imc))
   , temperature_ges_(std::move(temperature_ges))
+  , use_incremental_encoder_(Joint::usesIncrementalEncoder(this->imc_.get()))
 {
 }
 
@@ -47,21 +52,35 @@ bool Joint::initialize(int cycle_time)
   return reset;
 }
 
-void Joint::prepareActuation()
+bool Joint::stepPrepareActuation()
 {
   if (!this->canActuate())
   {
     throw error::HardwareException(error::ErrorType::NOT_ALLOWED_TO_ACTUATE, "Failed to prepare joint %s for actuation",
                                    this->name_.c_str());
   }
-  ROS_INFO("[%s] Preparing for actuation", this->name_.c_str());
-  this->imc_->goToOperationEnabled();
+  if (!this->imc_->stepToOperationEnabled())
+  {
+    return false;
+  }
   ROS_INFO("[%s] Successfully prepared for actuation", this->name_.c_str());
 
-  this->incremental_position_ = this->imc_->getAngleRadIncremental();
-  this->absolute_position_ = this->imc_->getAngleRadAbsolute();
-  this->position_ = this->absolute_position_;
-  this->velocity_ = 0;
+  this->initializeStatePosition();
+  return true;
+}
+
+void Joint::initializeStatePosition()
+{
+  if (this->state_)
+  {
+    this->storeState(*this->state_, this->state_index_);
+    this->state_->initializePosition(this->state_index_);
+  }
+}
+
+bool Joint::usesIncrementalEncoder(const IMotionCube* imc)
+{
+  return imc != nullptr && imc->getIncrementalRadPerBit() < imc->getAbsoluteRadPerBit();
 }
 
 void Joint::resetIMotionCube()
@@ -76,59 +95,73 @@ void Joint::resetIMotionCube()
   }
 }
 
-void Joint::actuateRad(double target_position)
+void Joint::readInputs(bool fresh)
 {
-  if (!this->canActuate())
+  if (fresh && this->hasIMotionCube())
   {
-    throw error::HardwareException(error::ErrorType::NOT_ALLOWED_TO_ACTUATE, "Joint %s is not allowed to actuate",
-                                   this->name_.c_str());
+    this->imc_->readInputs();
   }
-  this->imc_->actuateRad(target_position);
 }
 
-void Joint::readEncoders(const ros::Duration& elapsed_time)
+void Joint::writeOutputs()
 {
-  if (!this->hasIMotionCube())
+  if (this->hasIMotionCube())
   {
-    ROS_WARN("[%s] Has no iMotionCube", this->name_.c_str());
-    return;
+    this->imc_->writeOutputs();
   }
+}
 
-  if (this->receivedDataUpdate())
+void Joint::configureState(RobotState& state, size_t index)
+{
+  this->state_ = &state;
+  this->state_index_ = index;
+  if (this->hasIMotionCube())
   {
-    const double incremental_position_change = this->imc_->getAngleRadIncremental() - this->incremental_position_;
-
-    // Take the velocity and position from the encoder with the highest resolution.
-    if (this->imc_->getIncrementalRadPerBit() < this->imc_->getAbsoluteRadPerBit())
-    {
-      this->velocity_ = this->imc_->getVelocityRadIncremental();
-      this->position_ += incremental_position_change;
-    }
-    else
-    {
-      this->velocity_ = this->imc_->getVelocityRadAbsolute();
-      this->position_ = this->imc_->getAngleRadAbsolute();
-    }
-    this->incremental_position_ += incremental_position_change;
-    this->absolute_position_ = this->imc_->getAngleRadAbsolute();
+    this->imc_->configureState(state, index);
+    state.setUsesIncrementalEncoder(index, this->use_incremental_encoder_);
   }
-  else
+}
+
+void Joint::storeState(RobotState& state, size_t index) const
+{
+  if (this->hasIMotionCube())
+  {
+    this->imc_->storeState(state, index);
+  }
+  if (this->hasTemperatureGES())
+  {
+    state.setTemperature(index, this->temperature_ges_->getTemperature());
+  }
+}
+
+void Joint::actuateRad(double target_position)
+{
+  if (!this->canActuate())
   {
-    // Update positions with velocity from last time step
-    this->position_ += this->velocity_ * elapsed_time.toSec();
-    this->incremental_position_ += this->velocity_ * elapsed_time.toSec();
-    this->absolute_position_ += this->velocity_ * elapsed_time.toSec();
+    throw error::HardwareException(error::ErrorType::NOT_ALLOWED_TO_ACTUATE, "Joint %s is not allowed to actuate",
+                                   this->name_.c_str());
   }
+  this->imc_->actuateRad(target_position);
 }
 
 double Joint::getPosition() const
 {
-  return this->position_;
+  return this->state_ ? this->state_->getPositions()[this->state_index_] : 0.0;
 }
 
 double Joint::getVelocity() const
 {
-  return this->velocity_;
+  return this->state_ ? this->state_->getVelocities()[this->state_index_] : 0.0;
+}
+
+double Joint::getIncrementalPosition() const
+{
+  return this->state_ ? this->state_->getIncrementalPositions()[this->state_index_] : 0.0;
+}
+
+double Joint::getAbsolutePosition() const
+{
+  return this->state_ ? this->state_->get(RobotState::Quantity::AbsolutePosition)[this->state_index_] : 0.0;
 }
 
 double Joint::getVoltageVelocity() const
@@ -143,16 +176,6 @@ double Joint::getVoltageVelocity() const
   return (this->imc_->getMotorVoltage() + this->imc_->getMotorCurrent() * resistance) / electric_constant;
 }
 
-double Joint::getIncrementalPosition() const
-{
-  return this->incremental_position_;
-}
-
-double Joint::getAbsolutePosition() const
-{
-  return this->absolute_position_;
-}
-
 void Joint::actuateTorque(int16_t target_torque)
 {
   if (!this->canActuate())
@@ -279,6 +302,20 @@ int Joint::getIMotionCubeSlaveIndex() const
   return -1;
 }
 
+size_t Joint::getSdoTransferCount() const
+{
+  size_t count = 0;
+  if (this->hasIMotionCube())
+  {
+    count += this->imc_->getSdoTransferCount();
+  }
+  if (this->hasTemperatureGES())
+  {
+    count += this->temperature_ges_->getSdoTransferCount();
+  }
+  return count;
+}
+
 int Joint::getNetNumber() const
 {
   return this->net_number_;
@@ -304,38 +341,6 @@ bool Joint::canActuate() const
   return this->allow_actuation_ && this->hasIMotionCube();
 }
 
-bool Joint::receivedDataUpdate()
-{
-  if (!this->hasIMotionCube())
-  {
-    return false;
-  }
-  // If imc voltage, motor current, and both encoders positions and velocities did not change,
-  // we probably did not receive an update for this joint.
-  float new_imc_volt = this->imc_->getIMCVoltage();
-  float new_motor_volt = this->imc_->getMotorVoltage();
-  float new_motor_current = this->imc_->getMotorCurrent();
-  double new_absolute_position = this->imc_->getAngleRadAbsolute();
-  double new_incremental_position = this->imc_->getAngleRadIncremental();
-  double new_absolute_velocity = this->imc_->getVelocityRadAbsolute();
-  double new_incremental_velocity = this->imc_->getVelocityRadIncremental();
-  bool data_updated = (new_imc_volt != this->previous_imc_volt_ || new_motor_volt != this->previous_motor_volt_ ||
-                       new_motor_current != this->previous_motor_current_ ||
-                       new_absolute_position != this->previous_absolute_position_ ||
-                       new_incremental_position != this->previous_incremental_position_ ||
-                       new_absolute_velocity != this->previous_absolute_velocity_ ||
-                       new_incremental_velocity != this->previous_incremental_velocity_);
-
-  this->previous_imc_volt_ = new_imc_volt;
-  this->previous_motor_volt_ = new_motor_volt;
-  this->previous_motor_current_ = new_motor_current;
-  this->previous_absolute_position_ = new_absolute_position;
-  this->previous_incremental_position_ = new_incremental_position;
-  this->previous_absolute_velocity_ = new_absolute_velocity;
-  this->previous_incremental_velocity_ = new_incremental_velocity;
-  return data_updated;
-}
-
 ActuationMode Joint::getActuationMode() const
 {
   return this->imc_->getActuationMode();
@@ -5,6 +5,7 @@
 #include "march_hardware/error/hardware_exception.h"
 
 #include <algorithm>
+#include <exception>
 #include <memory>
 #include <string>
 #include <utility>
@@ -14,23 +15,37 @@
 
 namespace march
 {
-MarchRobot::MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf, ::std::string ifName, int ecatCycleTime,
-                       int ecatSlaveTimeout)
+MarchRobot::MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf, ::std::string ifName, int ecatCycleTimeUs,
+                       int ecatSlaveTimeout, int ecatSpinTime, int ecatSlowGroupDivider)
   : jointList(std::move(jointList))
   , urdf_(std::move(urdf))
-  , ethercatMaster(ifName, this->getMaxSlaveIndex(), ecatCycleTime, ecatSlaveTimeout)
+  , ethercatMaster(ifName, this->getMaxSlaveIndex(), ecatCycleTimeUs, ecatSlaveTimeout, ecatSpinTime,
+                   ecatSlowGroupDivider)
   , pdb_(nullptr)
+  , robot_state_(this->jointList.size())
 {
+  this->configureRobotState();
 }
 
 MarchRobot::MarchRobot(::std::vector<Joint> jointList, urdf::Model urdf,
                        std::unique_ptr<PowerDistributionBoard> powerDistributionBoard, ::std::string ifName,
-                       int ecatCycleTime, int ecatSlaveTimeout)
+                       int ecatCycleTimeUs, int ecatSlaveTimeout, int ecatSpinTime, int ecatSlowGroupDivider)
   : jointList(std::move(jointList))
   , urdf_(std::move(urdf))
-  , ethercatMaster(ifName, this->getMaxSlaveIndex(), ecatCycleTime, ecatSlaveTimeout)
+  , ethercatMaster(ifName, this->getMaxSlaveIndex(), ecatCycleTimeUs, ecatSlaveTimeout, ecatSpinTime,
+                   ecatSlowGroupDivider)
   , pdb_(std::move(powerDistributionBoard))
+  , robot_state_(this->jointList.size())
 {
+  this->configureRobotState();
+}
+
+void MarchRobot::configureRobotState()
+{
+  for (size_t i = 0; i < this->jointList.size(); i++)
+  {
+    this->jointList[i].configureState(this->robot_state_, i);
+  }
 }
 
 void MarchRobot::startEtherCAT(bool reset_imc)
@@ -48,18 +63,7 @@ void MarchRobot::startEtherCAT(bool reset_imc)
     return;
   }
 
-  bool sw_reset = ethercatMaster.start(this->jointList);
-
-  if (reset_imc || sw_reset)
-  {
-    ROS_DEBUG("Resetting all IMotionCubes due to either: reset arg: %d or downloading of .sw fie: %d", reset_imc,
-              sw_reset);
-    resetIMotionCubes();
-
-    ROS_INFO("Restarting the EtherCAT Master");
-    ethercatMaster.stop();
-    sw_reset = ethercatMaster.start(this->jointList);
-  }
+  ethercatMaster.start(this->jointList, reset_imc);
 }
 
 void MarchRobot::stopEtherCAT()
@@ -81,6 +85,59 @@ void MarchRobot::resetIMotionCubes()
   }
 }
 
+void MarchRobot::prepareActuation()
+{
+  std::vector<Joint*> pending_joints;
+  for (auto& joint : jointList)
+  {
+    if (joint.canActuate())
+    {
+      pending_joints.push_back(&joint);
+    }
+  }
+  ROS_INFO("Preparing %zu joints for actuation", pending_joints.size());
+  const auto start_time = StartupTimeline::Clock::now();
+
+  const int max_cycles = std::max(1, PREPARE_ACTUATION_TIMEOUT_MS * 1000 / this->ethercatMaster.getCycleTime());
+  int cycles = 0;
+  while (!pending_joints.empty())
+  {
+    if (cycles >= max_cycles)
+    {
+      std::string joint_names;
+      for (const Joint* joint : pending_joints)
+      {
+        joint_names += " " + joint->getName();
+      }
+      throw error::HardwareException(error::ErrorType::PREPARE_ACTUATION_TIMEOUT,
+                                     "After %d cycles the following joints are not prepared for actuation:%s", cycles,
+                                     joint_names.c_str());
+    }
+    // Every step writes a control word, which has to be sent before the next status word is read
+    if (!this->ethercatMaster.waitForCycle())
+    {
+      // The inputs are stale once the loop stopped, so the cause of the stop is reported instead of stepping on
+      const std::exception_ptr exception = this->ethercatMaster.getLastException();
+      if (exception)
+      {
+        std::rethrow_exception(exception);
+      }
+      throw error::HardwareException(error::ErrorType::ETHERCAT_LOOP_STOPPED,
+                                     "The EtherCAT loop stopped after %d cycles of preparing for actuation", cycles);
+    }
+    this->readInputs(true);
+    cycles++;
+
+    pending_joints.erase(std::remove_if(pending_joints.begin(), pending_joints.end(),
+                                        [](Joint* joint) { return joint->stepPrepareActuation(); }),
+                         pending_joints.end());
+    this->writeOutputs();
+  }
+  this->robot_state_.initializePositions();
+  this->getStartupTimeline().record("prepare actuation", start_time);
+  ROS_INFO("Prepared all joints for actuation in %d cycles", cycles);
+}
+
 int MarchRobot::getMaxSlaveIndex()
 {
   int maxSlaveIndex = -1;
@@ -164,7 +221,53 @@ std::exception_ptr MarchRobot::getLastEthercatException() const noexcept
 
 void MarchRobot::waitForPdo()
 {
-  this->ethercatMaster.waitForPdo();
+  this->writeOutputs();
+  this->readInputs(this->ethercatMaster.waitForPdo());
+}
+
+void MarchRobot::readInputs(bool fresh)
+{
+  for (Joint& joint : this->jointList)
+  {
+    joint.readInputs(fresh);
+  }
+  if (fresh)
+  {
+    for (size_t i = 0; i < this->jointList.size(); i++)
+    {
+      this->jointList[i].storeState(this->robot_state_, i);
+    }
+    this->robot_state_.convert();
+  }
+}
+
+void MarchRobot::writeOutputs()
+{
+  for (Joint& joint : this->jointList)
+  {
+    joint.writeOutputs();
+  }
+}
+
+void MarchRobot::setEthercatCycleCallback(EthercatMaster::CycleCallback callback)
+{
+  this->ethercatMaster.setCycleCallback([this, callback = std::move(callback)]() {
+    // The callback only runs when the PDO was received
+    this->readInputs(true);
+    callback();
+    this->writeOutputs();
+  });
+}
+
+const RobotState& MarchRobot::updateRobotState(double elapsed_seconds)
+{
+  this->robot_state_.update(elapsed_seconds);
+  return this->robot_state_;
+}
+
+const RobotState& MarchRobot::getRobotState() const
+{
+  return this->robot_state_;
 }
 
 int MarchRobot::getEthercatCycleTime() const
@@ -172,6 +275,36 @@ int MarchRobot::getEthercatCycleTime() const
   return this->ethercatMaster.getCycleTime();
 }
 
+void MarchRobot::setEthercatRealtimeConfig(RealtimeConfig config)
+{
+  this->ethercatMaster.setRealtimeConfig(std::move(config));
+}
+
+void MarchRobot::setControllerRealtimeConfig(RealtimeConfig config)
+{
+  this->controller_realtime_config_ = std::move(config);
+}
+
+const RealtimeConfig& MarchRobot::getControllerRealtimeConfig() const
+{
+  return this->controller_realtime_config_;
+}
+
+EthercatCycleTimings MarchRobot::getEthercatCycleTimings() const
+{
+  return this->ethercatMaster.getCycleTimings();
+}
+
+EthercatDiagnostics MarchRobot::getEthercatDiagnostics() const
+{
+  return this->ethercatMaster.getDiagnostics();
+}
+
+StartupTimeline& MarchRobot::getStartupTimeline()
+{
+  return this->ethercatMaster.getStartupTimeline();
+}
+
 Joint& MarchRobot::getJoint(::std::string jointName)
 {
   if (!ethercatMaster.isOperational())
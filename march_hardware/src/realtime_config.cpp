@@ -0,0 +1,149 @@
+// Copyright 2020 Project March.
+#include "march_hardware/realtime_config.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <ros/ros.h>
+
+namespace march
+{
+namespace
+{
+// Part of the stack that is never prefaulted, since it is already in use or reserved as guard
+const size_t PREFAULT_STACK_MARGIN = 64 * 1024;
+
+size_t getStackSize()
+{
+  pthread_attr_t attributes;
+  size_t stack_size = 0;
+  if (pthread_getattr_np(pthread_self(), &attributes) == 0)
+  {
+    pthread_attr_getstacksize(&attributes, &stack_size);
+    pthread_attr_destroy(&attributes);
+  }
+  return stack_size;
+}
+
+// Not inlined, so the allocated stack is released on return while its pages stay mapped
+__attribute__((noinline)) void prefaultStack(size_t size)
+{
+  volatile unsigned char* stack = static_cast<unsigned char*>(alloca(size));
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  for (size_t i = 0; i < size; i += page_size)
+  {
+    stack[i] = 0;
+  }
+}
+}  // namespace
+
+RealtimeReport applyRealtimeConfig(const RealtimeConfig& config)
+{
+  RealtimeReport report;
+
+  if (config.lock_memory)
+  {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) == 0)
+    {
+      report.memory_locked = true;
+    }
+    else
+    {
+      ROS_WARN("Failed to lock memory: %s", std::strerror(errno));
+    }
+  }
+
+  if (!config.cpus.empty())
+  {
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    for (int cpu : config.cpus)
+    {
+      if (cpu < 0 || cpu >= CPU_SETSIZE)
+      {
+        ROS_WARN("Ignoring invalid CPU %d", cpu);
+        continue;
+      }
+      CPU_SET(cpu, &cpu_set);
+    }
+    const int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (error != 0)
+    {
+      ROS_WARN("Failed to set the CPU affinity: %s", std::strerror(error));
+    }
+  }
+
+  if (config.priority > 0)
+  {
+    struct sched_param param = { config.priority };
+    const int error = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (error != 0)
+    {
+      ROS_WARN("Failed to set the thread priority to %d: %s", config.priority, std::strerror(error));
+    }
+  }
+
+  if (config.prefault_stack_size > 0)
+  {
+    const size_t stack_size = getStackSize();
+    const size_t available = stack_size > PREFAULT_STACK_MARGIN ? stack_size - PREFAULT_STACK_MARGIN : 0;
+    report.prefaulted_stack_size = std::min(config.prefault_stack_size, available);
+    if (report.prefaulted_stack_size < config.prefault_stack_size)
+    {
+      ROS_WARN("Prefaulting %zu bytes of stack instead of %zu, since the stack is only %zu bytes",
+               report.prefaulted_stack_size, config.prefault_stack_size, stack_size);
+    }
+    prefaultStack(report.prefaulted_stack_size);
+  }
+
+  int policy = 0;
+  struct sched_param param = { 0 };
+  if (pthread_getschedparam(pthread_self(), &policy, &param) == 0 && policy == SCHED_FIFO)
+  {
+    report.priority = param.sched_priority;
+  }
+
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0)
+  {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+    {
+      if (CPU_ISSET(cpu, &cpu_set))
+      {
+        report.cpus.push_back(cpu);
+      }
+    }
+  }
+
+  return report;
+}
+
+std::ostream& operator<<(std::ostream& os, const RealtimeReport& report)
+{
+  os << "priority: ";
+  if (report.priority > 0)
+  {
+    os << "SCHED_FIFO " << report.priority;
+  }
+  else
+  {
+    os << "not real-time";
+  }
+  os << ", cpus: [";
+  for (size_t i = 0; i < report.cpus.size(); i++)
+  {
+    os << (i > 0 ? ", " : "") << report.cpus[i];
+  }
+  os << "], memory locked: " << (report.memory_locked ? "yes" : "no")
+     << ", prefaulted stack: " << report.prefaulted_stack_size << " bytes";
+  return os;
+}
+}  // namespace march
@@ -0,0 +1,107 @@
+// Copyright 2020 Project March.
+#include "march_hardware/robot_state.h"
+#include "march_hardware/iu_conversion.h"
+
+namespace march
+{
+RobotState::RobotState(size_t joint_count)
+  : temperature_(joint_count, 0.0)
+  , uses_incremental_encoder_(joint_count, false)
+  , position_(joint_count, 0.0)
+  , velocity_(joint_count, 0.0)
+  , incremental_position_(joint_count, 0.0)
+{
+  for (size_t quantity = 0; quantity < QUANTITY_COUNT; quantity++)
+  {
+    this->iu_[quantity].assign(joint_count, 0);
+    this->offset_iu_[quantity].assign(joint_count, 0.0);
+    this->scale_[quantity].assign(joint_count, 0.0);
+    this->si_[quantity].assign(joint_count, 0.0);
+  }
+  for (size_t reg = 0; reg < REGISTER_COUNT; reg++)
+  {
+    this->registers_[reg].assign(joint_count, 0);
+  }
+}
+
+size_t RobotState::size() const
+{
+  return this->position_.size();
+}
+
+void RobotState::setConversion(Quantity quantity, size_t joint, double scale, double offset_iu)
+{
+  this->scale_[static_cast<size_t>(quantity)][joint] = scale;
+  this->offset_iu_[static_cast<size_t>(quantity)][joint] = offset_iu;
+}
+
+void RobotState::setUsesIncrementalEncoder(size_t joint, bool uses_incremental_encoder)
+{
+  this->uses_incremental_encoder_[joint] = uses_incremental_encoder;
+}
+
+void RobotState::convert()
+{
+  const size_t joint_count = this->size();
+  for (size_t quantity = 0; quantity < QUANTITY_COUNT; quantity++)
+  {
+    convertIU(this->iu_[quantity].data(), this->offset_iu_[quantity].data(), this->scale_[quantity].data(),
+              this->si_[quantity].data(), joint_count);
+  }
+  this->converted_ = true;
+}
+
+void RobotState::initializePositions()
+{
+  this->position_ = this->get(Quantity::AbsolutePosition);
+  this->incremental_position_ = this->get(Quantity::IncrementalPosition);
+  this->velocity_.assign(this->size(), 0.0);
+  this->converted_ = false;
+}
+
+void RobotState::initializePosition(size_t joint)
+{
+  for (Quantity quantity : { Quantity::AbsolutePosition, Quantity::IncrementalPosition })
+  {
+    const size_t column = static_cast<size_t>(quantity);
+    convertIU(&this->iu_[column][joint], &this->offset_iu_[column][joint], &this->scale_[column][joint],
+              &this->si_[column][joint], 1);
+  }
+  this->position_[joint] = this->get(Quantity::AbsolutePosition)[joint];
+  this->incremental_position_[joint] = this->get(Quantity::IncrementalPosition)[joint];
+  this->velocity_[joint] = 0.0;
+}
+
+void RobotState::update(double elapsed_seconds)
+{
+  const std::vector<double>& absolute_position = this->get(Quantity::AbsolutePosition);
+  const std::vector<double>& incremental_position = this->get(Quantity::IncrementalPosition);
+  const std::vector<double>& absolute_velocity = this->get(Quantity::AbsoluteVelocity);
+  const std::vector<double>& incremental_velocity = this->get(Quantity::IncrementalVelocity);
+
+  for (size_t joint = 0; joint < this->size(); joint++)
+  {
+    if (this->converted_)
+    {
+      if (this->uses_incremental_encoder_[joint])
+      {
+        this->velocity_[joint] = incremental_velocity[joint];
+        this->position_[joint] += incremental_position[joint] - this->incremental_position_[joint];
+      }
+      else
+      {
+        this->velocity_[joint] = absolute_velocity[joint];
+        this->position_[joint] = absolute_position[joint];
+      }
+      this->incremental_position_[joint] = incremental_position[joint];
+    }
+    else
+    {
+      // Update positions with velocity from last time step
+      this->position_[joint] += this->velocity_[joint] * elapsed_seconds;
+      this->incremental_position_[joint] += this->velocity_[joint] * elapsed_seconds;
+    }
+  }
+  this->converted_ = false;
+}
+}  // namespace march
@@ -0,0 +1,90 @@
+// Copyright 2020 Project March.
+#include "march_hardware/startup_timeline.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+namespace march
+{
+namespace
+{
+double toMilliseconds(std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double, std::milli>(duration).count();
+}
+}  // namespace
+
+StartupTimeline::StartupTimeline() : start_time_(Clock::now())
+{
+}
+
+void StartupTimeline::clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->start_time_ = Clock::now();
+  this->phases_.clear();
+}
+
+void StartupTimeline::record(const std::string& name, Clock::time_point start_time, int slave, size_t sdo_transfers)
+{
+  const Clock::time_point end_time = Clock::now();
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  StartupPhase phase;
+  phase.name = name;
+  phase.slave = slave;
+  phase.start = start_time - this->start_time_;
+  phase.duration = end_time - start_time;
+  phase.sdo_transfers = sdo_transfers;
+  this->phases_.push_back(phase);
+}
+
+std::vector<StartupPhase> StartupTimeline::getPhases() const
+{
+  std::vector<StartupPhase> phases;
+  {
+    std::lock_guard<std::mutex> lock(this->mutex_);
+    phases = this->phases_;
+  }
+  // Phases are recorded when they end, so enclosing phases are recorded after the phases within them
+  std::stable_sort(phases.begin(), phases.end(),
+                   [](const StartupPhase& lhs, const StartupPhase& rhs) { return lhs.start < rhs.start; });
+  return phases;
+}
+
+void StartupTimeline::writeCsv(std::ostream& os) const
+{
+  os << "phase,slave,start_us,duration_us,sdo_transfers\n";
+  for (const StartupPhase& phase : this->getPhases())
+  {
+    os << phase.name << ',' << phase.slave << ','
+       << std::chrono::duration_cast<std::chrono::microseconds>(phase.start).count() << ','
+       << std::chrono::duration_cast<std::chrono::microseconds>(phase.duration).count() << ',' << phase.sdo_transfers
+       << '\n';
+  }
+}
+
+std::ostream& operator<<(std::ostream& os, const StartupTimeline& timeline)
+{
+  const std::vector<StartupPhase> phases = timeline.getPhases();
+  std::chrono::nanoseconds end{ 0 };
+  for (const StartupPhase& phase : phases)
+  {
+    end = std::max(end, phase.start + phase.duration);
+  }
+
+  // Formatted separately, so the format flags of the given stream are left untouched
+  std::ostringstream ss;
+  ss << "Start-up took " << std::fixed << std::setprecision(1) << toMilliseconds(end) << " ms";
+  for (const StartupPhase& phase : phases)
+  {
+    ss << "\n  at " << std::setw(8) << toMilliseconds(phase.start) << " ms took " << std::setw(8)
+       << toMilliseconds(phase.duration) << " ms: " << phase.name;
+    if (phase.slave > 0)
+    {
+      ss << " (slave " << phase.slave << ", " << phase.sdo_transfers << " SDO transfers)";
+    }
+  }
+  return os << ss.str();
+}
+}  // namespace march
@@ -12,10 +12,8 @@ using testing::Eq;
 using testing::Return;
 
 /**
- * This test fixture uses the MockEncoder to test non virtual methods
- * of the Encoder abstract class. Otherwise it is not possible to
- * instantiate a pure abstract class. So as long as the non virtual
- * methods are tested all is ok.
+ * This test fixture uses the MockEncoder to test the methods of the
+ * Encoder base class, since its constructor is protected.
  */
 class EncoderTest : public testing::Test
 {
@@ -54,3 +52,18 @@ TEST_F(EncoderTest, CorrectTotalPositions)
   MockEncoder encoder(this->resolution);
   ASSERT_EQ(std::pow(2, this->resolution), encoder.getTotalPositions());
 }
+
+TEST_F(EncoderTest, GetVelocityRad)
+{
+  MockEncoder encoder(this->resolution);
+  const uint8_t expected_offset = 8;
+  march::bit32 result;
+  result.i = 3 << 16;
+  MockPdoInterfacePtr mock_pdo = std::make_shared<MockPdoInterface>();
+  march::PdoSlaveInterface pdo(this->slave_index, mock_pdo);
+
+  EXPECT_CALL(*mock_pdo, read32(this->slave_index, Eq(expected_offset))).WillOnce(Return(result));
+
+  const double expected = 3 / march::Encoder::TIME_PER_VELOCITY_SAMPLE * encoder.getRadPerBit();
+  ASSERT_DOUBLE_EQ(expected, encoder.getVelocityRad(pdo, expected_offset));
+}
@@ -24,3 +24,16 @@ TEST_F(IncrementalEncoderTest, CorrectToRad)
   const double expected = iu * 2.0 * M_PI / (std::pow(2, this->resolution) * this->transmission);
   ASSERT_DOUBLE_EQ(expected, this->encoder.toRad(iu));
 }
+
+TEST_F(IncrementalEncoderTest, CorrectRadPerBit)
+{
+  const double expected = 2.0 * M_PI / (std::pow(2, this->resolution) * this->transmission);
+  ASSERT_DOUBLE_EQ(expected, this->encoder.getRadPerBit());
+}
+
+TEST_F(IncrementalEncoderTest, CorrectToVelocityRad)
+{
+  const int32_t velocity = 1 << 16;
+  const double expected = march::Encoder::toVelocityIU(velocity) * this->encoder.getRadPerBit();
+  ASSERT_DOUBLE_EQ(expected, this->encoder.toVelocityRad(velocity));
+}
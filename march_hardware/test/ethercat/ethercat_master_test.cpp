@@ -0,0 +1,44 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/ethercat_master.h"
+#include "march_hardware/error/hardware_exception.h"
+
+#include <gtest/gtest.h>
+#include <soem/ethercat.h>
+
+TEST(EthercatMasterTest, SpinTimeWithinCycle)
+{
+  march::EthercatMaster master("eth0", 1, 4000, 200, 3999);
+  ASSERT_EQ(4000, master.getCycleTime());
+}
+
+TEST(EthercatMasterTest, NegativeSpinTime)
+{
+  ASSERT_THROW(march::EthercatMaster("eth0", 1, 4000, 200, -1), march::error::HardwareException);
+}
+
+TEST(EthercatMasterTest, SpinTimeOfWholeCycle)
+{
+  ASSERT_THROW(march::EthercatMaster("eth0", 1, 4000, 200, 4000), march::error::HardwareException);
+}
+
+TEST(EthercatMasterTest, SlowGroupPeriodBeyondWatchdog)
+{
+  ASSERT_THROW(march::EthercatMaster("eth0", 1, 4000, 200, 0, 13), march::error::HardwareException);
+}
+
+TEST(EthercatMasterTest, SlowGroupDividerOverflow)
+{
+  ASSERT_THROW(march::EthercatMaster("eth0", 1, 4000, 200, 0, 1 << 30), march::error::HardwareException);
+}
+
+TEST(EthercatMasterTest, SlowGroupNeedsSoemGroups)
+{
+  if (EC_MAXGROUP > march::EthercatMaster::SLOW_GROUP)
+  {
+    ASSERT_NO_THROW(march::EthercatMaster("eth0", 1, 4000, 200, 0, 10));
+  }
+  else
+  {
+    ASSERT_THROW(march::EthercatMaster("eth0", 1, 4000, 200, 0, 10), march::error::HardwareException);
+  }
+}
@@ -0,0 +1,62 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/io_map.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+class IoMapTest : public testing::Test
+{
+protected:
+  march::IoMap io_map;
+};
+
+TEST_F(IoMapTest, EmptyByDefault)
+{
+  ASSERT_EQ(nullptr, this->io_map.data());
+  ASSERT_EQ(0u, this->io_map.size());
+}
+
+TEST_F(IoMapTest, AlignedToCacheLine)
+{
+  this->io_map.allocate(100);
+
+  ASSERT_EQ(0u, reinterpret_cast<uintptr_t>(this->io_map.data()) % march::IoMap::ALIGNMENT);
+}
+
+TEST_F(IoMapTest, SizeRoundedUpToCacheLines)
+{
+  this->io_map.allocate(100);
+
+  ASSERT_EQ(128u, this->io_map.size());
+}
+
+TEST_F(IoMapTest, AllocatedZeroed)
+{
+  this->io_map.allocate(64);
+
+  for (size_t i = 0; i < this->io_map.size(); i++)
+  {
+    ASSERT_EQ(0, this->io_map.data()[i]);
+  }
+}
+
+TEST_F(IoMapTest, ReallocateReplacesBuffer)
+{
+  this->io_map.allocate(64);
+  this->io_map.data()[0] = 1;
+  this->io_map.allocate(256);
+
+  ASSERT_EQ(256u, this->io_map.size());
+  ASSERT_EQ(0, this->io_map.data()[0]);
+}
+
+TEST_F(IoMapTest, AllocateZeroSize)
+{
+  this->io_map.allocate(64);
+  this->io_map.allocate(0);
+
+  ASSERT_EQ(nullptr, this->io_map.data());
+  ASSERT_EQ(0u, this->io_map.size());
+  ASSERT_FALSE(this->io_map.isLocked());
+}
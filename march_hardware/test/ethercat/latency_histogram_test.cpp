@@ -0,0 +1,78 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/latency_histogram.h"
+
+#include <chrono>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+class LatencyHistogramTest : public testing::Test
+{
+protected:
+  march::LatencyHistogram histogram{ microseconds(1), 100 };
+};
+
+TEST_F(LatencyHistogramTest, ZeroBucketWidth)
+{
+  ASSERT_THROW(march::LatencyHistogram(nanoseconds(0), 100), std::invalid_argument);
+}
+
+TEST_F(LatencyHistogramTest, ZeroBuckets)
+{
+  ASSERT_THROW(march::LatencyHistogram(microseconds(1), 0), std::invalid_argument);
+}
+
+TEST_F(LatencyHistogramTest, EmptyStatistics)
+{
+  const march::LatencyStatistics statistics = this->histogram.getStatistics();
+  ASSERT_EQ(0u, statistics.count);
+  ASSERT_EQ(nanoseconds(0), statistics.max);
+}
+
+TEST_F(LatencyHistogramTest, MinMaxMean)
+{
+  this->histogram.record(microseconds(10));
+  this->histogram.record(microseconds(20));
+  this->histogram.record(microseconds(30));
+
+  const march::LatencyStatistics statistics = this->histogram.getStatistics();
+  ASSERT_EQ(3u, statistics.count);
+  ASSERT_EQ(microseconds(10), statistics.min);
+  ASSERT_EQ(microseconds(30), statistics.max);
+  ASSERT_EQ(microseconds(20), statistics.mean);
+}
+
+TEST_F(LatencyHistogramTest, Percentiles)
+{
+  for (int i = 0; i < 100; i++)
+  {
+    this->histogram.record(nanoseconds(i * 1000 + 500));
+  }
+
+  const march::LatencyStatistics statistics = this->histogram.getStatistics();
+  ASSERT_EQ(microseconds(50), statistics.p50);
+  ASSERT_EQ(microseconds(90), statistics.p90);
+  ASSERT_EQ(microseconds(99), statistics.p99);
+  ASSERT_EQ(nanoseconds(99500), statistics.p999);
+}
+
+TEST_F(LatencyHistogramTest, OverflowUsesMax)
+{
+  this->histogram.record(microseconds(500));
+
+  const march::LatencyStatistics statistics = this->histogram.getStatistics();
+  ASSERT_EQ(microseconds(500), statistics.p50);
+  ASSERT_EQ(microseconds(500), statistics.max);
+}
+
+TEST_F(LatencyHistogramTest, NegativeRecordedAsZero)
+{
+  this->histogram.record(nanoseconds(-10));
+
+  const march::LatencyStatistics statistics = this->histogram.getStatistics();
+  ASSERT_EQ(nanoseconds(0), statistics.min);
+  ASSERT_EQ(nanoseconds(0), statistics.p50);
+}
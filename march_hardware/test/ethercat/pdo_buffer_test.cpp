@@ -0,0 +1,82 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/pdo_buffer.h"
+
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+class PdoBufferTest : public testing::Test
+{
+protected:
+  std::array<uint8_t, 8> inputs = { { 0 } };
+  std::array<uint8_t, 8> outputs = { { 0 } };
+  march::PdoBuffer buffer = march::PdoBuffer(inputs.data(), outputs.data());
+};
+
+TEST_F(PdoBufferTest, HasInputsAndOutputs)
+{
+  ASSERT_TRUE(this->buffer.hasInputs());
+  ASSERT_TRUE(this->buffer.hasOutputs());
+}
+
+TEST_F(PdoBufferTest, WithoutProcessData)
+{
+  march::PdoBuffer empty(nullptr, nullptr);
+  ASSERT_FALSE(empty.hasInputs());
+  ASSERT_FALSE(empty.hasOutputs());
+}
+
+TEST_F(PdoBufferTest, Read8)
+{
+  this->inputs[3] = 0xAB;
+  ASSERT_EQ(0xAB, this->buffer.read8(3).ui);
+}
+
+TEST_F(PdoBufferTest, Read16LittleEndian)
+{
+  this->inputs = { { 0, 0x34, 0x12, 0, 0, 0, 0, 0 } };
+  ASSERT_EQ(0x1234, this->buffer.read16(1).ui);
+}
+
+TEST_F(PdoBufferTest, Read16Signed)
+{
+  this->inputs = { { 0xFE, 0xFF, 0, 0, 0, 0, 0, 0 } };
+  ASSERT_EQ(-2, this->buffer.read16(0).i);
+}
+
+TEST_F(PdoBufferTest, Read32Unaligned)
+{
+  this->inputs = { { 0, 0, 0, 0x78, 0x56, 0x34, 0x12, 0 } };
+  ASSERT_EQ(0x12345678u, this->buffer.read32(3).ui);
+}
+
+TEST_F(PdoBufferTest, Write16LittleEndian)
+{
+  march::bit16 value;
+  value.ui = 0x1234;
+  this->buffer.write16(1, value);
+
+  std::array<uint8_t, 8> expected = { { 0, 0x34, 0x12, 0, 0, 0, 0, 0 } };
+  ASSERT_EQ(expected, this->outputs);
+}
+
+TEST_F(PdoBufferTest, Write32Unaligned)
+{
+  march::bit32 value;
+  value.i = -2;
+  this->buffer.write32(3, value);
+
+  std::array<uint8_t, 8> expected = { { 0, 0, 0, 0xFE, 0xFF, 0xFF, 0xFF, 0 } };
+  ASSERT_EQ(expected, this->outputs);
+}
+
+TEST_F(PdoBufferTest, WriteDoesNotTouchInputs)
+{
+  march::bit8 value;
+  value.ui = 7;
+  this->buffer.write8(0, value);
+
+  ASSERT_EQ(7, this->outputs[0]);
+  ASSERT_EQ(0, this->inputs[0]);
+}
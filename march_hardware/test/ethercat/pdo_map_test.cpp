@@ -2,6 +2,10 @@
 #include "../mocks/mock_sdo_interface.h"
 #include "march_hardware/ethercat/pdo_map.h"
 
+#include <algorithm>
+#include <vector>
+
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 class PDOTest : public ::testing::Test
@@ -77,3 +81,122 @@ TEST_F(PDOTest, CombinedAdressConstructWithSubindexValue)
   ASSERT_EQ(2u, ((combined_address >> 8) & 0xFF));
   ASSERT_EQ(0x6060u, ((combined_address >> 16) & 0xFFFF));
 }
+
+TEST_F(PDOTest, CompleteAccessWritesWholeRegisters)
+{
+  march::PDOmap pdoMapMISO;
+  pdoMapMISO.addObject(march::IMCObjectName::StatusWord);
+  pdoMapMISO.addObject(march::IMCObjectName::ActualPosition);
+
+  std::vector<uint8_t> register_data;
+  std::vector<uint8_t> sync_manager_data;
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(1, 0x1A00, testing::_, testing::_))
+      .WillOnce(testing::Invoke([&](uint16_t, uint16_t, std::size_t size, void* data) {
+        register_data.assign(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+        return 1;
+      }));
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(1, testing::AllOf(testing::Ge(0x1A01), testing::Le(0x1A03)), 2,
+                                                   testing::_))
+      .Times(3)
+      .WillRepeatedly(testing::Return(1));
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(1, 0x1C13, testing::_, testing::_))
+      .WillOnce(testing::Invoke([&](uint16_t, uint16_t, std::size_t size, void* data) {
+        sync_manager_data.assign(static_cast<uint8_t*>(data), static_cast<uint8_t*>(data) + size);
+        return 1;
+      }));
+  EXPECT_CALL(*this->mock_sdo, write(testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+  pdoMapMISO.map(this->sdo, march::DataDirection::MISO);
+
+  // Amount of entries, padding and then the combined addresses in little endian
+  std::vector<uint8_t> expected_register = { 2, 0, 0x20, 0x00, 0x64, 0x60, 0x10, 0x00, 0x41, 0x60 };
+  ASSERT_EQ(expected_register, register_data);
+  std::vector<uint8_t> expected_sync_manager = { 1, 0, 0x00, 0x1A };
+  ASSERT_EQ(expected_sync_manager, sync_manager_data);
+}
+
+TEST_F(PDOTest, CompleteAccessRejectedWritesPerEntry)
+{
+  march::PDOmap pdoMapMOSI;
+  pdoMapMOSI.addObject(march::IMCObjectName::ControlWord);
+
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(1, 0x1600, testing::_, testing::_)).WillOnce(testing::Return(0));
+  // Disable, map the object and enable the register
+  EXPECT_CALL(*this->mock_sdo, write(1, 0x1600, testing::_, testing::_, testing::_)).Times(3);
+  // Unused registers
+  EXPECT_CALL(*this->mock_sdo, write(1, testing::AllOf(testing::Ge(0x1601), testing::Le(0x1603)), 0, 1, testing::_))
+      .Times(3);
+  // Disable, assign the register and enable the sync manager
+  EXPECT_CALL(*this->mock_sdo, write(1, 0x1C12, testing::_, testing::_, testing::_)).Times(3);
+
+  std::unordered_map<march::IMCObjectName, uint8_t> mosiByteOffsets =
+      pdoMapMOSI.map(this->sdo, march::DataDirection::MOSI);
+  ASSERT_EQ(0u, mosiByteOffsets[march::IMCObjectName::ControlWord]);
+}
+
+TEST_F(PDOTest, SkipRemappingWhenAlreadyMapped)
+{
+  march::PDOmap pdoMapMOSI;
+  pdoMapMOSI.addObject(march::IMCObjectName::ControlWord);
+  pdoMapMOSI.addObject(march::IMCObjectName::TargetPosition);
+
+  // Sync manager with register 0x1600 assigned, which holds the target position and control word
+  std::vector<uint8_t> sync_manager_data = { 1, 0, 0x00, 0x16 };
+  std::vector<uint8_t> register_data = { 2, 0, 0x20, 0x00, 0x7A, 0x60, 0x10, 0x00, 0x40, 0x60 };
+  const auto read_data = [](const std::vector<uint8_t>& result) {
+    return [result](uint16_t, uint16_t, int& size, void* data) {
+      std::copy(result.begin(), result.end(), static_cast<uint8_t*>(data));
+      size = result.size();
+      return 1;
+    };
+  };
+  EXPECT_CALL(*this->mock_sdo, readCompleteAccess(1, 0x1C12, testing::_, testing::_))
+      .WillOnce(testing::Invoke(read_data(sync_manager_data)));
+  EXPECT_CALL(*this->mock_sdo, readCompleteAccess(1, 0x1600, testing::_, testing::_))
+      .WillOnce(testing::Invoke(read_data(register_data)));
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(testing::_, testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*this->mock_sdo, write(testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+  std::unordered_map<march::IMCObjectName, uint8_t> mosiByteOffsets =
+      pdoMapMOSI.map(this->sdo, march::DataDirection::MOSI);
+  ASSERT_EQ(0u, mosiByteOffsets[march::IMCObjectName::TargetPosition]);
+  ASSERT_EQ(4u, mosiByteOffsets[march::IMCObjectName::ControlWord]);
+}
+
+TEST_F(PDOTest, RemapWhenMappingDiffers)
+{
+  march::PDOmap pdoMapMOSI;
+  pdoMapMOSI.addObject(march::IMCObjectName::ControlWord);
+
+  // Sync manager with no registers assigned
+  EXPECT_CALL(*this->mock_sdo, readCompleteAccess(1, 0x1C12, testing::_, testing::_))
+      .WillOnce(testing::Invoke([](uint16_t, uint16_t, int& size, void* data) {
+        static_cast<uint8_t*>(data)[0] = 0;
+        size = 2;
+        return 1;
+      }));
+  EXPECT_CALL(*this->mock_sdo, writeCompleteAccess(1, testing::_, testing::_, testing::_))
+      .Times(5)
+      .WillRepeatedly(testing::Return(1));
+
+  pdoMapMOSI.map(this->sdo, march::DataDirection::MOSI);
+}
+
+TEST(IMCObjectOffsetsTest, NothingMapped)
+{
+  march::IMCObjectOffsets offsets;
+  ASSERT_FALSE(offsets.isMapped(march::IMCObjectName::StatusWord));
+  ASSERT_EQ(0u, offsets[march::IMCObjectName::StatusWord]);
+}
+
+TEST(IMCObjectOffsetsTest, ResolvedFromMap)
+{
+  march::IMCObjectOffsets offsets(
+      { { march::IMCObjectName::ActualPosition, 0 }, { march::IMCObjectName::MotorVoltage, 6 } });
+
+  ASSERT_TRUE(offsets.isMapped(march::IMCObjectName::ActualPosition));
+  ASSERT_EQ(0u, offsets[march::IMCObjectName::ActualPosition]);
+  ASSERT_TRUE(offsets.isMapped(march::IMCObjectName::MotorVoltage));
+  ASSERT_EQ(6u, offsets[march::IMCObjectName::MotorVoltage]);
+  ASSERT_FALSE(offsets.isMapped(march::IMCObjectName::StatusWord));
+}
@@ -0,0 +1,145 @@
+// Copyright 2020 Project March.
+#include "march_hardware/ethercat/process_image.h"
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+class ProcessImageTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // Outputs at [0, 4) and inputs at [4, 8) of the io map
+    this->process_image.configure({ { 0, 4 } }, { { 4, 4 } });
+  }
+
+  march::ProcessImage process_image;
+  std::array<uint8_t, 8> io_map = { { 0 } };
+  std::array<uint8_t, 8> image = { { 0 } };
+};
+
+TEST_F(ProcessImageTest, NothingPublished)
+{
+  ASSERT_EQ(0u, this->process_image.getSequence());
+  ASSERT_EQ(0u, this->process_image.acquireInputs(this->image.data()));
+}
+
+TEST_F(ProcessImageTest, AcquirePublishedInputs)
+{
+  this->io_map = { { 0, 0, 0, 0, 1, 2, 3, 4 } };
+  this->process_image.publishInputs(this->io_map.data());
+
+  ASSERT_EQ(1u, this->process_image.acquireInputs(this->image.data()));
+  std::array<uint8_t, 8> expected = { { 0, 0, 0, 0, 1, 2, 3, 4 } };
+  ASSERT_EQ(expected, this->image);
+}
+
+TEST_F(ProcessImageTest, AcquireLatestInputs)
+{
+  this->io_map[4] = 1;
+  this->process_image.publishInputs(this->io_map.data());
+  this->io_map[4] = 2;
+  this->process_image.publishInputs(this->io_map.data());
+
+  ASSERT_EQ(2u, this->process_image.acquireInputs(this->image.data()));
+  ASSERT_EQ(2, this->image[4]);
+}
+
+TEST_F(ProcessImageTest, AcquireWithoutNewInputsKeepsSnapshot)
+{
+  this->io_map[4] = 1;
+  this->process_image.publishInputs(this->io_map.data());
+  this->process_image.acquireInputs(this->image.data());
+
+  ASSERT_EQ(1u, this->process_image.acquireInputs(this->image.data()));
+  ASSERT_EQ(1, this->image[4]);
+}
+
+TEST_F(ProcessImageTest, OutputsUntouchedBeforeCommit)
+{
+  this->io_map[0] = 5;
+  this->process_image.fetchOutputs(this->io_map.data());
+
+  ASSERT_EQ(5, this->io_map[0]);
+}
+
+TEST_F(ProcessImageTest, FetchCommittedOutputs)
+{
+  this->image = { { 1, 2, 3, 4, 9, 9, 9, 9 } };
+  this->process_image.commitOutputs(this->image.data());
+  this->process_image.fetchOutputs(this->io_map.data());
+
+  std::array<uint8_t, 8> expected = { { 1, 2, 3, 4, 0, 0, 0, 0 } };
+  ASSERT_EQ(expected, this->io_map);
+}
+
+TEST_F(ProcessImageTest, FetchKeepsLastCommittedOutputs)
+{
+  this->image[0] = 1;
+  this->process_image.commitOutputs(this->image.data());
+  this->process_image.fetchOutputs(this->io_map.data());
+
+  this->io_map[0] = 0;
+  this->process_image.fetchOutputs(this->io_map.data());
+  ASSERT_EQ(1, this->io_map[0]);
+}
+
+TEST_F(ProcessImageTest, WaitReturnsForNewerSequence)
+{
+  this->process_image.publishInputs(this->io_map.data());
+
+  ASSERT_TRUE(this->process_image.waitForInputs(0));
+}
+
+TEST_F(ProcessImageTest, WaitWakesOnPublish)
+{
+  std::thread publisher([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    this->process_image.publishInputs(this->io_map.data());
+  });
+
+  ASSERT_TRUE(this->process_image.waitForInputs(0));
+  publisher.join();
+}
+
+TEST_F(ProcessImageTest, WaitWakesOnInterrupt)
+{
+  std::thread interrupter([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    this->process_image.interrupt();
+  });
+
+  ASSERT_FALSE(this->process_image.waitForInputs(0));
+  interrupter.join();
+}
+
+TEST_F(ProcessImageTest, ConfigureResetsInterrupt)
+{
+  this->process_image.interrupt();
+  this->process_image.configure({ { 0, 4 } }, { { 4, 4 } });
+  this->process_image.publishInputs(this->io_map.data());
+
+  ASSERT_TRUE(this->process_image.waitForInputs(0));
+}
+
+TEST_F(ProcessImageTest, MultipleRanges)
+{
+  // Two groups with each an output and an input byte
+  this->process_image.configure({ { 0, 1 }, { 2, 1 } }, { { 1, 1 }, { 3, 1 } });
+
+  this->io_map = { { 0, 5, 0, 6, 0, 0, 0, 0 } };
+  this->process_image.publishInputs(this->io_map.data());
+  this->process_image.acquireInputs(this->image.data());
+  std::array<uint8_t, 8> expected_inputs = { { 0, 5, 0, 6, 0, 0, 0, 0 } };
+  ASSERT_EQ(expected_inputs, this->image);
+
+  this->image = { { 1, 9, 2, 9, 9, 9, 9, 9 } };
+  this->process_image.commitOutputs(this->image.data());
+  this->process_image.fetchOutputs(this->io_map.data());
+  std::array<uint8_t, 8> expected_outputs = { { 1, 5, 2, 6, 0, 0, 0, 0 } };
+  ASSERT_EQ(expected_outputs, this->io_map);
+}
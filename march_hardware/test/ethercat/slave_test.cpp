@@ -35,3 +35,24 @@ TEST_F(SlaveTest, InvalidSlaveIndex)
 {
   ASSERT_THROW(march::Slave(0, this->mock_pdo, this->mock_sdo), march::error::HardwareException);
 }
+
+TEST_F(SlaveTest, SdoSlaveInterfaceCountsTransfers)
+{
+  EXPECT_CALL(*this->mock_sdo, write(1, 0x1C12, 0, sizeof(uint8_t), testing::_)).WillOnce(testing::Return(1));
+  EXPECT_CALL(*this->mock_sdo, read(1, 0x1C12, 0, testing::_, testing::_)).WillOnce(testing::Return(1));
+  march::SdoSlaveInterface sdo(1, this->mock_sdo);
+
+  sdo.write<uint8_t>(0x1C12, 0, 0);
+  int size = sizeof(uint8_t);
+  uint8_t value = 0;
+  sdo.read<uint8_t>(0x1C12, 0, size, value);
+
+  ASSERT_EQ(2u, sdo.getTransferCount());
+}
+
+TEST_F(SlaveTest, NoSdoTransfersWithoutInitialization)
+{
+  march::Slave slave(1, this->mock_pdo, this->mock_sdo);
+  ASSERT_FALSE(slave.initSdo(1));
+  ASSERT_EQ(0u, slave.getSdoTransferCount());
+}
@@ -77,5 +77,73 @@ TEST_F(IMotionCubeTest, OperationEnabledWithoutActuationMode)
 {
   march::IMotionCube imc(mock_slave, std::move(this->mock_absolute_encoder), std::move(this->mock_incremental_encoder),
                          march::ActuationMode::unknown);
-  ASSERT_THROW(imc.goToOperationEnabled(), march::error::HardwareException);
+  ASSERT_THROW(imc.stepToOperationEnabled(), march::error::HardwareException);
+}
+
+TEST_F(IMotionCubeTest, GettersServeInputsDecodedOnce)
+{
+  const march::bit16 word = { .ui = 0x0237 };
+  const march::bit32 position = { .i = 1000 };
+  // Without a mapping all objects are read at offset 0
+  EXPECT_CALL(*this->mock_pdo, read16(1, 0)).Times(7).WillRepeatedly(testing::Return(word));
+  EXPECT_CALL(*this->mock_pdo, read32(1, 0)).Times(4).WillRepeatedly(testing::Return(position));
+  march::IMotionCube imc(mock_slave, std::move(this->mock_absolute_encoder), std::move(this->mock_incremental_encoder),
+                         march::ActuationMode::position);
+
+  imc.readInputs();
+
+  ASSERT_EQ(0x0237, imc.getStatusWord());
+  ASSERT_EQ(0x0237, imc.getStatusWord());
+  ASSERT_EQ(0x0237, imc.getSecondDetailedError());
+  ASSERT_EQ(1000, imc.getAngleIUAbsolute());
+  ASSERT_EQ(1000, imc.getAngleIUIncremental());
+  ASSERT_EQ(0x0237, imc.getTorque());
+  ASSERT_EQ(1000, imc.getInputs().incremental_velocity);
+}
+
+TEST_F(IMotionCubeTest, OutputsAreStaged)
+{
+  EXPECT_CALL(*this->mock_pdo, write16(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*this->mock_pdo, write32(testing::_, testing::_, testing::_)).Times(0);
+  march::IMotionCube imc(mock_slave, std::move(this->mock_absolute_encoder), std::move(this->mock_incremental_encoder),
+                         march::ActuationMode::torque);
+
+  imc.setControlWord(15);
+  imc.actuateTorque(100);
+
+  ASSERT_EQ(15, imc.getOutputs().control_word);
+  ASSERT_EQ(100, imc.getOutputs().target_torque);
+}
+
+TEST_F(IMotionCubeTest, NoOutputsWrittenBeforeMapping)
+{
+  EXPECT_CALL(*this->mock_pdo, write16(testing::_, testing::_, testing::_)).Times(0);
+  EXPECT_CALL(*this->mock_pdo, write32(testing::_, testing::_, testing::_)).Times(0);
+  march::IMotionCube imc(mock_slave, std::move(this->mock_absolute_encoder), std::move(this->mock_incremental_encoder),
+                         march::ActuationMode::torque);
+
+  imc.setControlWord(15);
+  imc.writeOutputs();
+}
+
+TEST_F(IMotionCubeTest, StepToOperationEnabledWithoutActuationMode)
+{
+  march::IMotionCube imc(mock_slave, std::move(this->mock_absolute_encoder), std::move(this->mock_incremental_encoder),
+                         march::ActuationMode::unknown);
+  ASSERT_THROW(imc.stepToOperationEnabled(), march::error::HardwareException);
+}
+
+TEST_F(IMotionCubeTest, WatchdogTimeDefaultCycleTime)
+{
+  ASSERT_EQ(500, march::IMotionCube::getWatchdogTime(4000));
+}
+
+TEST_F(IMotionCubeTest, WatchdogTimeScalesWithCycleTime)
+{
+  ASSERT_EQ(125, march::IMotionCube::getWatchdogTime(1000));
+}
+
+TEST_F(IMotionCubeTest, WatchdogTimeMinimum)
+{
+  ASSERT_EQ(10, march::IMotionCube::getWatchdogTime(40));
 }
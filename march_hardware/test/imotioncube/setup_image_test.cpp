@@ -0,0 +1,79 @@
+// Copyright 2020 Project March.
+#include "march_hardware/error/hardware_exception.h"
+#include "march_hardware/imotioncube/setup_image.h"
+
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(SetupImageTest, ParseSetup)
+{
+  std::istringstream sw("4000\n0001\n00a0\nFFFF\n\n");
+
+  march::SetupImage setup = march::SetupImage::parse(sw);
+
+  ASSERT_EQ(0x4000, setup.getStartAddress());
+  ASSERT_EQ(std::vector<uint16_t>({ 0x0001, 0x00A0, 0xFFFF }), setup.getWords());
+}
+
+TEST(SetupImageTest, ChecksumWrapsAround)
+{
+  march::SetupImage setup(0x4000, { 0x0001, 0x00A0, 0xFFFF });
+
+  ASSERT_EQ(0x00A0, setup.getChecksum());
+}
+
+TEST(SetupImageTest, EndAddress)
+{
+  march::SetupImage setup(0x4000, { 0x0001, 0x00A0, 0xFFFF });
+
+  ASSERT_EQ(0x4003, setup.getEndAddress());
+}
+
+TEST(SetupImageTest, StopsAtEmptyLine)
+{
+  std::istringstream sw("4000\n0001\n\n5000\n0002\n\n");
+
+  march::SetupImage setup = march::SetupImage::parse(sw);
+
+  ASSERT_EQ(std::vector<uint16_t>({ 0x0001 }), setup.getWords());
+}
+
+TEST(SetupImageTest, WindowsLineEndings)
+{
+  std::istringstream sw("4000\r\n0001\r\n\r\n");
+
+  march::SetupImage setup = march::SetupImage::parse(sw);
+
+  ASSERT_EQ(0x4000, setup.getStartAddress());
+  ASSERT_EQ(std::vector<uint16_t>({ 0x0001 }), setup.getWords());
+}
+
+TEST(SetupImageTest, NoEmptyLine)
+{
+  std::istringstream sw("4000\n0001\n");
+
+  ASSERT_THROW(march::SetupImage::parse(sw), march::error::HardwareException);
+}
+
+TEST(SetupImageTest, NoStartAddress)
+{
+  std::istringstream sw("\n0001\n\n");
+
+  ASSERT_THROW(march::SetupImage::parse(sw), march::error::HardwareException);
+}
+
+TEST(SetupImageTest, InvalidWord)
+{
+  std::istringstream sw("4000\n00x1\n\n");
+
+  ASSERT_THROW(march::SetupImage::parse(sw), march::error::HardwareException);
+}
+
+TEST(SetupImageTest, WordExceeds16Bits)
+{
+  std::istringstream sw("4000\n10000\n\n");
+
+  ASSERT_THROW(march::SetupImage::parse(sw), march::error::HardwareException);
+}
@@ -0,0 +1,64 @@
+// Copyright 2020 Project March.
+#include "march_hardware/iu_conversion.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(IUConversionTest, NoValues)
+{
+  ASSERT_NO_THROW(march::convertIU(nullptr, nullptr, nullptr, nullptr, 0));
+}
+
+TEST(IUConversionTest, AffineTransform)
+{
+  const std::vector<int32_t> iu = { 10, -20 };
+  const std::vector<double> offset = { 4, 0 };
+  const std::vector<double> scale = { 0.5, 0.25 };
+  std::vector<double> si(2);
+
+  march::convertIU(iu.data(), offset.data(), scale.data(), si.data(), si.size());
+
+  ASSERT_DOUBLE_EQ(3.0, si[0]);
+  ASSERT_DOUBLE_EQ(-5.0, si[1]);
+}
+
+TEST(IUConversionTest, EqualToScalarConversionForAllCounts)
+{
+  // Covers the vectorized parts as well as the remaining values
+  for (size_t count = 1; count <= 11; count++)
+  {
+    std::vector<int32_t> iu(count);
+    std::vector<double> offset(count);
+    std::vector<double> scale(count);
+    for (size_t i = 0; i < count; i++)
+    {
+      iu[i] = static_cast<int32_t>(i * 1021) - 4000;
+      offset[i] = static_cast<double>(i * 37);
+      scale[i] = 1.0 / (i + 3);
+    }
+    std::vector<double> si(count);
+
+    march::convertIU(iu.data(), offset.data(), scale.data(), si.data(), count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+      ASSERT_EQ((iu[i] - offset[i]) * scale[i], si[i]) << "count " << count << ", index " << i;
+    }
+  }
+}
+
+TEST(IUConversionTest, ExtremeValues)
+{
+  const std::vector<int32_t> iu = { INT32_MIN, INT32_MAX, 0 };
+  const std::vector<double> offset = { 0, 0, 0 };
+  const std::vector<double> scale = { 1, 1, 1 };
+  std::vector<double> si(3);
+
+  march::convertIU(iu.data(), offset.data(), scale.data(), si.data(), si.size());
+
+  ASSERT_EQ(static_cast<double>(INT32_MIN), si[0]);
+  ASSERT_EQ(static_cast<double>(INT32_MAX), si[1]);
+  ASSERT_EQ(0.0, si[2]);
+}
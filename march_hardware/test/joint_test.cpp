@@ -12,7 +12,10 @@
 
 using testing::_;
 using testing::Eq;
+using testing::Invoke;
+using testing::NiceMock;
 using testing::Return;
+using testing::ReturnPointee;
 
 class JointTest : public testing::Test
 {
@@ -23,8 +26,40 @@ protected:
     this->temperature_ges = std::make_unique<MockTemperatureGES>();
   }
 
+  /**
+   * Creates an iMotionCube that decodes its inputs from the PDO. Without a mapping all objects are read at offset 0,
+   * so the encoder positions and velocities are all encoder_iu. The drive is enabled on the first step.
+   */
+  std::unique_ptr<MockIMotionCube> createDecodingIMotionCube()
+  {
+    auto pdo = std::make_shared<NiceMock<MockPdoInterface>>();
+    ON_CALL(*pdo, read32(_, _)).WillByDefault(ReturnPointee(&this->encoder_iu));
+    const MockSlave slave(pdo, std::make_shared<MockSdoInterface>());
+    std::unique_ptr<MockIMotionCube> decoding_imc = std::make_unique<NiceMock<MockIMotionCube>>(slave);
+    MockIMotionCube* imc_ptr = decoding_imc.get();
+    ON_CALL(*decoding_imc, readInputs()).WillByDefault(Invoke([imc_ptr]() {
+      imc_ptr->march::IMotionCube::readInputs();
+    }));
+    ON_CALL(*decoding_imc, stepToOperationEnabled()).WillByDefault(Return(true));
+    return decoding_imc;
+  }
+
+  /**
+   * Reads the inputs of the joint in a new cycle and converts them in the robot state, like MarchRobot does.
+   */
+  void readCycle(march::Joint& joint, march::RobotState& state, int32_t new_encoder_iu)
+  {
+    this->encoder_iu.i = new_encoder_iu;
+    joint.readInputs(true);
+    joint.storeState(state, 0);
+    state.convert();
+  }
+
   std::unique_ptr<MockIMotionCube> imc;
   std::unique_ptr<MockTemperatureGES> temperature_ges;
+  march::bit32 encoder_iu = { .i = 0 };
+  const MockAbsoluteEncoder absolute_encoder;
+  const MockIncrementalEncoder incremental_encoder;
 };
 
 TEST_F(JointTest, InitializeWithoutMotorControllerAndGes)
@@ -123,19 +158,6 @@ TEST_F(JointTest, ActuateTorque)
   ASSERT_NO_THROW(joint.actuateTorque(expected_torque));
 }
 
-TEST_F(JointTest, PrepareForActuationNotAllowed)
-{
-  march::Joint joint("actuate_false", 0, false, std::move(this->imc));
-  ASSERT_THROW(joint.prepareActuation(), march::error::HardwareException);
-}
-
-TEST_F(JointTest, PrepareForActuationAllowed)
-{
-  EXPECT_CALL(*this->imc, goToOperationEnabled()).Times(1);
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  ASSERT_NO_THROW(joint.prepareActuation());
-}
-
 TEST_F(JointTest, GetTemperature)
 {
   const float expected_temperature = 45.0;
@@ -167,154 +189,168 @@ TEST_F(JointTest, ResetControllerWithoutController)
 
 TEST_F(JointTest, TestPrepareActuation)
 {
-  EXPECT_CALL(*this->imc, getAngleRadIncremental()).WillOnce(Return(5));
-  EXPECT_CALL(*this->imc, getAngleRadAbsolute()).WillOnce(Return(3));
-  EXPECT_CALL(*this->imc, goToOperationEnabled()).Times(1);
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.prepareActuation();
-  ASSERT_EQ(joint.getIncrementalPosition(), 5);
-  ASSERT_EQ(joint.getAbsolutePosition(), 3);
+  march::RobotState state(1);
+  march::Joint joint("actuate_true", 0, true, this->createDecodingIMotionCube());
+  joint.configureState(state, 0);
+  this->encoder_iu.i = 1000;
+  joint.readInputs(true);
+  ASSERT_TRUE(joint.stepPrepareActuation());
+
+  ASSERT_DOUBLE_EQ(joint.getAbsolutePosition(), this->absolute_encoder.toRad(1000));
+  ASSERT_DOUBLE_EQ(joint.getIncrementalPosition(), this->incremental_encoder.toRad(1000));
+  ASSERT_DOUBLE_EQ(joint.getPosition(), this->absolute_encoder.toRad(1000));
+  ASSERT_EQ(joint.getVelocity(), 0.0);
 }
 
-TEST_F(JointTest, TestReceivedDataUpdateFirstTimeTrue)
+TEST_F(JointTest, StepPrepareActuationNotAllowed)
 {
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillOnce(Return(48));
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  ASSERT_TRUE(joint.receivedDataUpdate());
+  march::Joint joint("actuate_false", 0, false, std::move(this->imc));
+  ASSERT_THROW(joint.stepPrepareActuation(), march::error::HardwareException);
 }
 
-TEST_F(JointTest, TestReceivedDataUpdateTrue)
+TEST_F(JointTest, StepPrepareActuationPending)
 {
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillOnce(Return(48)).WillOnce(Return(48.001));
+  EXPECT_CALL(*this->imc, stepToOperationEnabled()).WillOnce(Return(false));
+  march::RobotState state(1);
   march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.receivedDataUpdate();
-  ASSERT_TRUE(joint.receivedDataUpdate());
+  joint.configureState(state, 0);
+  state.setIU(march::RobotState::Quantity::AbsolutePosition, 0, 1000);
+  ASSERT_FALSE(joint.stepPrepareActuation());
+  ASSERT_EQ(joint.getPosition(), 0.0);
 }
 
-TEST_F(JointTest, TestReceivedDataUpdateFalse)
+TEST_F(JointTest, StepPrepareActuationUntilEnabled)
 {
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillRepeatedly(Return(48));
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.receivedDataUpdate();
-  ASSERT_FALSE(joint.receivedDataUpdate());
+  auto decoding_imc = this->createDecodingIMotionCube();
+  EXPECT_CALL(*decoding_imc, stepToOperationEnabled()).WillOnce(Return(false)).WillOnce(Return(true));
+  march::RobotState state(1);
+  march::Joint joint("actuate_true", 0, true, std::move(decoding_imc));
+  joint.configureState(state, 0);
+  this->encoder_iu.i = 1000;
+  joint.readInputs(true);
+  ASSERT_FALSE(joint.stepPrepareActuation());
+  ASSERT_TRUE(joint.stepPrepareActuation());
+
+  ASSERT_DOUBLE_EQ(joint.getAbsolutePosition(), this->absolute_encoder.toRad(1000));
+  ASSERT_DOUBLE_EQ(joint.getIncrementalPosition(), this->incremental_encoder.toRad(1000));
+  ASSERT_DOUBLE_EQ(joint.getPosition(), this->absolute_encoder.toRad(1000));
 }
 
 TEST_F(JointTest, TestReadEncodersOnce)
 {
-  ros::Duration elapsed_time(0.2);
-  double velocity = 0.5;
-  double velocity_with_noise = velocity - 2 * this->imc->getAbsoluteRadPerBit() / elapsed_time.toSec();
-
-  double initial_incremental_position = 5;
-  double initial_absolute_position = 3;
-
-  double new_incremental_position = initial_incremental_position + velocity * elapsed_time.toSec();
-  double new_absolute_position = initial_absolute_position + velocity_with_noise * elapsed_time.toSec();
-
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillOnce(Return(48));
-  EXPECT_CALL(*this->imc, getMotorCurrent()).WillOnce(Return(5));
-  EXPECT_CALL(*this->imc, getAngleRadIncremental())
-      .WillOnce(Return(initial_incremental_position))
-      .WillOnce(Return(new_incremental_position))
-      .WillOnce(Return(new_incremental_position));
-  EXPECT_CALL(*this->imc, getAngleRadAbsolute())
-      .WillOnce(Return(initial_absolute_position))
-      .WillOnce(Return(new_absolute_position))
-      .WillOnce(Return(new_absolute_position));
-
-  EXPECT_CALL(*this->imc, getVelocityRadIncremental()).WillOnce(Return(velocity)).WillOnce(Return(velocity));
-  EXPECT_CALL(*this->imc, getVelocityRadAbsolute()).WillOnce(Return(velocity_with_noise));
-
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.prepareActuation();
-
-  joint.readEncoders(elapsed_time);
-
-  ASSERT_DOUBLE_EQ(joint.getPosition(), initial_absolute_position + velocity * elapsed_time.toSec());
-  ASSERT_NEAR(joint.getVelocity(), (new_incremental_position - initial_incremental_position) / elapsed_time.toSec(),
-              0.0000001);
+  march::RobotState state(1);
+  march::Joint joint("actuate_true", 0, true, this->createDecodingIMotionCube());
+  joint.configureState(state, 0);
+  this->readCycle(joint, state, 1000);
+  ASSERT_TRUE(joint.stepPrepareActuation());
+
+  this->readCycle(joint, state, 1010);
+  state.update(0.2);
+
+  // The incremental encoder has the highest resolution, so it supplies the position change and velocity
+  const double incremental_change = this->incremental_encoder.toRad(1010) - this->incremental_encoder.toRad(1000);
+  ASSERT_DOUBLE_EQ(joint.getPosition(), this->absolute_encoder.toRad(1000) + incremental_change);
+  ASSERT_DOUBLE_EQ(joint.getVelocity(), this->incremental_encoder.toVelocityRad(1010));
+  ASSERT_DOUBLE_EQ(joint.getIncrementalPosition(), this->incremental_encoder.toRad(1010));
+  ASSERT_DOUBLE_EQ(joint.getAbsolutePosition(), this->absolute_encoder.toRad(1010));
 }
 
 TEST_F(JointTest, TestReadEncodersTwice)
 {
-  ros::Duration elapsed_time(0.2);
-  double first_velocity = 0.5;
-  double second_velocity = 0.8;
-
-  double absolute_noise = -this->imc->getAbsoluteRadPerBit();
-  double first_velocity_with_noise = first_velocity + absolute_noise / elapsed_time.toSec();
-  double second_velocity_with_noise = second_velocity + absolute_noise / elapsed_time.toSec();
-
-  double initial_incremental_position = 5;
-  double initial_absolute_position = 3;
-  double second_incremental_position = initial_incremental_position + first_velocity * elapsed_time.toSec();
-  double second_absolute_position = initial_absolute_position + first_velocity * elapsed_time.toSec();
-  double third_incremental_position = second_incremental_position + second_velocity * elapsed_time.toSec();
-  double third_absolute_position = second_absolute_position + second_velocity_with_noise * elapsed_time.toSec();
-
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillOnce(Return(48)).WillOnce(Return(48.01));
-  EXPECT_CALL(*this->imc, getAngleRadIncremental())
-      .WillOnce(Return(initial_incremental_position))
-      .WillOnce(Return(second_incremental_position))
-      .WillOnce(Return(second_incremental_position))
-      .WillOnce(Return(third_incremental_position))
-      .WillOnce(Return(third_incremental_position));
-  EXPECT_CALL(*this->imc, getAngleRadAbsolute())
-      .WillOnce(Return(initial_absolute_position))
-      .WillOnce(Return(second_absolute_position))
-      .WillOnce(Return(second_absolute_position))
-      .WillOnce(Return(third_absolute_position))
-      .WillOnce(Return(third_absolute_position));
-  EXPECT_CALL(*this->imc, getVelocityRadIncremental())
-      .WillOnce(Return(first_velocity))
-      .WillOnce(Return(first_velocity))
-      .WillOnce(Return(second_velocity))
-      .WillOnce(Return(second_velocity));
-  EXPECT_CALL(*this->imc, getVelocityRadAbsolute())
-      .WillOnce(Return(first_velocity_with_noise))
-      .WillOnce(Return(second_velocity_with_noise));
-
-  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.prepareActuation();
-
-  joint.readEncoders(elapsed_time);
-  joint.readEncoders(elapsed_time);
-
-  ASSERT_DOUBLE_EQ(joint.getPosition(),
-                   initial_absolute_position + (first_velocity + second_velocity) * elapsed_time.toSec());
-  ASSERT_NEAR(joint.getVelocity(), (third_incremental_position - second_incremental_position) / elapsed_time.toSec(),
-              0.0000001);
+  march::RobotState state(1);
+  march::Joint joint("actuate_true", 0, true, this->createDecodingIMotionCube());
+  joint.configureState(state, 0);
+  this->readCycle(joint, state, 1000);
+  ASSERT_TRUE(joint.stepPrepareActuation());
+
+  this->readCycle(joint, state, 1010);
+  state.update(0.2);
+  this->readCycle(joint, state, 1030);
+  state.update(0.2);
+
+  const double first_change = this->incremental_encoder.toRad(1010) - this->incremental_encoder.toRad(1000);
+  const double second_change = this->incremental_encoder.toRad(1030) - this->incremental_encoder.toRad(1010);
+  ASSERT_NEAR(joint.getPosition(), this->absolute_encoder.toRad(1000) + first_change + second_change, 0.0000001);
+  ASSERT_DOUBLE_EQ(joint.getVelocity(), this->incremental_encoder.toVelocityRad(1030));
 }
 
 TEST_F(JointTest, TestReadEncodersNoUpdate)
 {
-  ros::Duration elapsed_time(0.2);
-
-  double velocity = 0.5;
+  const double elapsed_seconds = 0.2;
+  march::RobotState state(1);
+  march::Joint joint("actuate_true", 0, true, this->createDecodingIMotionCube());
+  joint.configureState(state, 0);
+  this->readCycle(joint, state, 1000);
+  ASSERT_TRUE(joint.stepPrepareActuation());
+
+  this->readCycle(joint, state, 1010);
+  state.update(elapsed_seconds);
+  const double position = joint.getPosition();
+  const double velocity = joint.getVelocity();
+  this->encoder_iu.i = 1020;
+  joint.readInputs(false);
+  state.update(elapsed_seconds);
+
+  // Without new inputs the position is extrapolated with the last velocity
+  ASSERT_DOUBLE_EQ(joint.getPosition(), position + velocity * elapsed_seconds);
+  ASSERT_DOUBLE_EQ(joint.getVelocity(), this->incremental_encoder.toVelocityRad(1010));
+}
 
-  double absolute_noise = -this->imc->getAbsoluteRadPerBit();
+TEST_F(JointTest, TestReadFreshInputs)
+{
+  EXPECT_CALL(*this->imc, readInputs()).Times(1);
+  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
+  joint.readInputs(true);
+}
 
-  double initial_incremental_position = 5;
-  double initial_absolute_position = 3;
-  double second_incremental_position = initial_incremental_position + velocity * elapsed_time.toSec();
-  double second_absolute_position = initial_absolute_position + velocity * elapsed_time.toSec() + absolute_noise;
+TEST_F(JointTest, TestReadStaleInputs)
+{
+  EXPECT_CALL(*this->imc, readInputs()).Times(0);
+  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
+  joint.readInputs(false);
+}
 
-  EXPECT_CALL(*this->imc, getIMCVoltage()).WillRepeatedly(Return(48));
-  EXPECT_CALL(*this->imc, getAngleRadIncremental())
-      .WillOnce(Return(initial_incremental_position))
-      .WillRepeatedly(Return(second_incremental_position));
-  EXPECT_CALL(*this->imc, getAngleRadAbsolute())
-      .WillOnce(Return(initial_absolute_position))
-      .WillRepeatedly(Return(second_absolute_position));
-  EXPECT_CALL(*this->imc, getVelocityRadIncremental()).WillRepeatedly(Return(velocity));
-  EXPECT_CALL(*this->imc, getVelocityRadAbsolute()).WillRepeatedly(Return(velocity));
+TEST_F(JointTest, PositionWithoutRobotState)
+{
+  march::Joint joint("actuate_true", 0, true, std::move(this->imc));
+  ASSERT_EQ(joint.getPosition(), 0.0);
+  ASSERT_EQ(joint.getVelocity(), 0.0);
+}
 
+TEST_F(JointTest, ViewsRobotState)
+{
+  using Quantity = march::RobotState::Quantity;
+  march::RobotState state(2);
   march::Joint joint("actuate_true", 0, true, std::move(this->imc));
-  joint.prepareActuation();
+  joint.configureState(state, 1);
+
+  state.setUsesIncrementalEncoder(1, false);
+  state.setConversion(Quantity::AbsolutePosition, 1, 0.5, 10);
+  state.setConversion(Quantity::IncrementalPosition, 1, 0.25);
+  state.setConversion(Quantity::AbsoluteVelocity, 1, 0.5);
+  state.setIU(Quantity::AbsolutePosition, 1, 14);
+  state.setIU(Quantity::IncrementalPosition, 1, 20);
+  state.convert();
+  state.initializePositions();
+  state.setIU(Quantity::AbsolutePosition, 1, 16);
+  state.setIU(Quantity::AbsoluteVelocity, 1, 4);
+  state.convert();
+  state.update(0.1);
+
+  ASSERT_DOUBLE_EQ(joint.getPosition(), 3.0);
+  ASSERT_DOUBLE_EQ(joint.getVelocity(), 2.0);
+  ASSERT_DOUBLE_EQ(joint.getAbsolutePosition(), 3.0);
+  ASSERT_DOUBLE_EQ(joint.getIncrementalPosition(), 5.0);
+}
 
-  joint.readEncoders(elapsed_time);
-  joint.readEncoders(elapsed_time);
+TEST_F(JointTest, StoresTemperatureInRobotState)
+{
+  const float expected_temperature = 42.0;
+  EXPECT_CALL(*this->temperature_ges, getTemperature()).WillOnce(Return(expected_temperature));
+  march::RobotState state(1);
+  march::Joint joint("get_temperature", 0, false, nullptr, std::move(this->temperature_ges));
+  joint.configureState(state, 0);
+  joint.storeState(state, 0);
 
-  ASSERT_DOUBLE_EQ(joint.getPosition(), initial_absolute_position + 2 * velocity * elapsed_time.toSec());
-  ASSERT_DOUBLE_EQ(joint.getVelocity(), velocity);
+  ASSERT_DOUBLE_EQ(state.getTemperatures()[0], expected_temperature);
 }
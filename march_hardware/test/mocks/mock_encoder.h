@@ -6,11 +6,7 @@
 class MockEncoder : public march::Encoder
 {
 public:
-  explicit MockEncoder(size_t number_of_bits) : Encoder(number_of_bits)
+  explicit MockEncoder(size_t number_of_bits) : Encoder(number_of_bits, 1.0)
   {
   }
-
-  MOCK_CONST_METHOD1(toRad, double(int32_t));
-
-  MOCK_CONST_METHOD0(getRadPerBit, double());
 };
@@ -19,7 +19,15 @@ public:
   {
   }
 
-  MOCK_METHOD0(goToOperationEnabled, void());
+  explicit MockIMotionCube(const MockSlave& slave)
+    : IMotionCube(slave, std::make_unique<MockAbsoluteEncoder>(), std::make_unique<MockIncrementalEncoder>(),
+                  march::ActuationMode::unknown)
+  {
+  }
+
+  MOCK_METHOD0(readInputs, void());
+  MOCK_METHOD0(writeOutputs, void());
+  MOCK_METHOD0(stepToOperationEnabled, bool());
 
   MOCK_METHOD0(getAngleRadIncremental, double());
   MOCK_METHOD0(getAngleRadAbsolute, double());
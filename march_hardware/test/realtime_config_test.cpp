@@ -0,0 +1,76 @@
+// Copyright 2020 Project March.
+#include "march_hardware/realtime_config.h"
+
+#include <functional>
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+class RealtimeConfigTest : public testing::Test
+{
+protected:
+  // Applies the config in a separate thread, so the settings do not leak into other tests
+  march::RealtimeReport applyInThread(const march::RealtimeConfig& config)
+  {
+    march::RealtimeReport report;
+    std::thread thread([&] { report = march::applyRealtimeConfig(config); });
+    thread.join();
+    return report;
+  }
+};
+
+TEST_F(RealtimeConfigTest, EmptyConfigKeepsDefaults)
+{
+  march::RealtimeReport report = this->applyInThread(march::RealtimeConfig());
+
+  ASSERT_EQ(0, report.priority);
+  ASSERT_FALSE(report.cpus.empty());
+  ASSERT_FALSE(report.memory_locked);
+  ASSERT_EQ(0u, report.prefaulted_stack_size);
+}
+
+TEST_F(RealtimeConfigTest, PinToCpu)
+{
+  const int cpu = this->applyInThread(march::RealtimeConfig()).cpus.back();
+  march::RealtimeConfig config;
+  config.cpus = { cpu };
+
+  march::RealtimeReport report = this->applyInThread(config);
+
+  ASSERT_EQ(std::vector<int>({ cpu }), report.cpus);
+}
+
+TEST_F(RealtimeConfigTest, PrefaultStack)
+{
+  march::RealtimeConfig config;
+  config.prefault_stack_size = 256 * 1024;
+
+  march::RealtimeReport report = this->applyInThread(config);
+
+  ASSERT_EQ(256u * 1024, report.prefaulted_stack_size);
+}
+
+TEST_F(RealtimeConfigTest, PrefaultLimitedToStackSize)
+{
+  march::RealtimeConfig config;
+  config.prefault_stack_size = 1024ul * 1024 * 1024;
+
+  march::RealtimeReport report = this->applyInThread(config);
+
+  ASSERT_LT(report.prefaulted_stack_size, config.prefault_stack_size);
+}
+
+TEST_F(RealtimeConfigTest, PrintReport)
+{
+  march::RealtimeReport report;
+  report.priority = 40;
+  report.cpus = { 2, 3 };
+  report.memory_locked = true;
+  report.prefaulted_stack_size = 1024;
+
+  std::stringstream ss;
+  ss << report;
+
+  ASSERT_EQ("priority: SCHED_FIFO 40, cpus: [2, 3], memory locked: yes, prefaulted stack: 1024 bytes", ss.str());
+}
@@ -0,0 +1,156 @@
+// Copyright 2020 Project March.
+#include "march_hardware/robot_state.h"
+
+#include <gtest/gtest.h>
+
+using Quantity = march::RobotState::Quantity;
+using Register = march::RobotState::Register;
+
+class RobotStateTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    for (size_t joint = 0; joint < this->state.size(); joint++)
+    {
+      this->state.setConversion(Quantity::AbsolutePosition, joint, 0.5, 10);
+      this->state.setConversion(Quantity::IncrementalPosition, joint, 0.25);
+      this->state.setConversion(Quantity::AbsoluteVelocity, joint, 0.5);
+      this->state.setConversion(Quantity::IncrementalVelocity, joint, 0.25);
+    }
+    this->state.setUsesIncrementalEncoder(1, true);
+  }
+
+  void setInputs(size_t joint, int32_t absolute_position, int32_t incremental_position, int32_t absolute_velocity,
+                 int32_t incremental_velocity)
+  {
+    this->state.setIU(Quantity::AbsolutePosition, joint, absolute_position);
+    this->state.setIU(Quantity::IncrementalPosition, joint, incremental_position);
+    this->state.setIU(Quantity::AbsoluteVelocity, joint, absolute_velocity);
+    this->state.setIU(Quantity::IncrementalVelocity, joint, incremental_velocity);
+  }
+
+  march::RobotState state = march::RobotState(2);
+};
+
+TEST_F(RobotStateTest, Size)
+{
+  ASSERT_EQ(2u, this->state.size());
+  ASSERT_EQ(2u, this->state.get(Quantity::Effort).size());
+  ASSERT_EQ(2u, this->state.getPositions().size());
+}
+
+TEST_F(RobotStateTest, ConvertsAllJoints)
+{
+  this->setInputs(0, 14, 8, 2, 4);
+  this->setInputs(1, 20, 16, 6, 12);
+  this->state.convert();
+
+  ASSERT_DOUBLE_EQ(2.0, this->state.get(Quantity::AbsolutePosition)[0]);
+  ASSERT_DOUBLE_EQ(5.0, this->state.get(Quantity::AbsolutePosition)[1]);
+  ASSERT_DOUBLE_EQ(2.0, this->state.get(Quantity::IncrementalPosition)[0]);
+  ASSERT_DOUBLE_EQ(3.0, this->state.get(Quantity::IncrementalVelocity)[1]);
+}
+
+TEST_F(RobotStateTest, QuantityWithoutConversionIsZero)
+{
+  this->state.setIU(Quantity::MotorCurrent, 0, 100);
+  this->state.convert();
+
+  ASSERT_EQ(0.0, this->state.get(Quantity::MotorCurrent)[0]);
+}
+
+TEST_F(RobotStateTest, InitializePositionsFromAbsoluteEncoder)
+{
+  this->setInputs(0, 14, 8, 2, 4);
+  this->setInputs(1, 20, 16, 6, 12);
+  this->state.convert();
+  this->state.initializePositions();
+
+  ASSERT_DOUBLE_EQ(2.0, this->state.getPositions()[0]);
+  ASSERT_DOUBLE_EQ(5.0, this->state.getPositions()[1]);
+  ASSERT_EQ(0.0, this->state.getVelocities()[1]);
+}
+
+TEST_F(RobotStateTest, UpdateWithHighestResolutionEncoder)
+{
+  this->setInputs(0, 14, 8, 2, 4);
+  this->setInputs(1, 20, 16, 6, 12);
+  this->state.convert();
+  this->state.initializePositions();
+
+  this->setInputs(0, 18, 12, 2, 4);
+  this->setInputs(1, 22, 24, 6, 12);
+  this->state.convert();
+  this->state.update(0.1);
+
+  // The absolute encoder of joint 0 supplies its position and velocity
+  ASSERT_DOUBLE_EQ(4.0, this->state.getPositions()[0]);
+  ASSERT_DOUBLE_EQ(1.0, this->state.getVelocities()[0]);
+  // The position of joint 1 changes with its incremental encoder
+  ASSERT_DOUBLE_EQ(7.0, this->state.getPositions()[1]);
+  ASSERT_DOUBLE_EQ(3.0, this->state.getVelocities()[1]);
+}
+
+TEST_F(RobotStateTest, UpdateWithoutNewInputsExtrapolates)
+{
+  this->setInputs(0, 14, 8, 2, 4);
+  this->state.convert();
+  this->state.initializePositions();
+  this->state.convert();
+  this->state.update(0.1);
+
+  this->state.update(0.5);
+
+  ASSERT_DOUBLE_EQ(2.0 + 1.0 * 0.5, this->state.getPositions()[0]);
+  ASSERT_DOUBLE_EQ(1.0, this->state.getVelocities()[0]);
+}
+
+TEST_F(RobotStateTest, UpdateTwiceWithIncrementalEncoder)
+{
+  this->setInputs(1, 20, 16, 6, 12);
+  this->state.convert();
+  this->state.initializePositions();
+
+  this->setInputs(1, 20, 24, 6, 12);
+  this->state.convert();
+  this->state.update(0.1);
+  this->setInputs(1, 20, 28, 6, 8);
+  this->state.convert();
+  this->state.update(0.1);
+
+  ASSERT_DOUBLE_EQ(5.0 + 2.0 + 1.0, this->state.getPositions()[1]);
+  ASSERT_DOUBLE_EQ(2.0, this->state.getVelocities()[1]);
+  ASSERT_DOUBLE_EQ(7.0, this->state.getIncrementalPositions()[1]);
+}
+
+TEST_F(RobotStateTest, StoresRegisters)
+{
+  this->state.setRegister(Register::StatusWord, 1, 0x0237);
+  this->state.setRegister(Register::DetailedError, 0, 0x0008);
+
+  ASSERT_EQ(0x0237, this->state.get(Register::StatusWord)[1]);
+  ASSERT_EQ(0x0008, this->state.get(Register::DetailedError)[0]);
+  ASSERT_EQ(0, this->state.get(Register::MotionError)[0]);
+}
+
+TEST_F(RobotStateTest, StoresTemperatures)
+{
+  this->state.setTemperature(0, 36.5);
+
+  ASSERT_DOUBLE_EQ(36.5, this->state.getTemperatures()[0]);
+  ASSERT_EQ(0.0, this->state.getTemperatures()[1]);
+}
+
+TEST_F(RobotStateTest, InitializePositionOfOneJoint)
+{
+  this->setInputs(0, 14, 8, 2, 4);
+  this->setInputs(1, 20, 16, 6, 12);
+  this->state.initializePosition(1);
+
+  ASSERT_DOUBLE_EQ(5.0, this->state.getPositions()[1]);
+  ASSERT_DOUBLE_EQ(4.0, this->state.getIncrementalPositions()[1]);
+  ASSERT_EQ(0.0, this->state.getVelocities()[1]);
+  // The other joints are left untouched
+  ASSERT_EQ(0.0, this->state.getPositions()[0]);
+}
@@ -0,0 +1,82 @@
+// Copyright 2020 Project March.
+#include "march_hardware/startup_timeline.h"
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+class StartupTimelineTest : public testing::Test
+{
+protected:
+  march::StartupTimeline timeline;
+};
+
+TEST_F(StartupTimelineTest, NoPhases)
+{
+  ASSERT_TRUE(this->timeline.getPhases().empty());
+}
+
+TEST_F(StartupTimelineTest, RecordPhase)
+{
+  const auto start_time = march::StartupTimeline::Clock::now();
+  this->timeline.record("initialize", start_time, 3, 12);
+
+  const std::vector<march::StartupPhase> phases = this->timeline.getPhases();
+  ASSERT_EQ(1u, phases.size());
+  ASSERT_EQ("initialize", phases[0].name);
+  ASSERT_EQ(3, phases[0].slave);
+  ASSERT_EQ(12u, phases[0].sdo_transfers);
+  ASSERT_GE(phases[0].start.count(), 0);
+  ASSERT_GE(phases[0].duration.count(), 0);
+}
+
+TEST_F(StartupTimelineTest, PhasesOrderedByStart)
+{
+  const auto outer_start_time = march::StartupTimeline::Clock::now();
+  const auto inner_start_time = outer_start_time + std::chrono::milliseconds(1);
+  this->timeline.record("inner", inner_start_time);
+  this->timeline.record("outer", outer_start_time);
+
+  const std::vector<march::StartupPhase> phases = this->timeline.getPhases();
+  ASSERT_EQ(2u, phases.size());
+  ASSERT_EQ("outer", phases[0].name);
+  ASSERT_EQ("inner", phases[1].name);
+}
+
+TEST_F(StartupTimelineTest, ClearRemovesPhases)
+{
+  this->timeline.record("ec_init", march::StartupTimeline::Clock::now());
+  this->timeline.clear();
+
+  ASSERT_TRUE(this->timeline.getPhases().empty());
+}
+
+TEST_F(StartupTimelineTest, WriteCsv)
+{
+  this->timeline.record("ec_init", march::StartupTimeline::Clock::now());
+  this->timeline.record("initialize joint", march::StartupTimeline::Clock::now(), 2, 5);
+
+  std::stringstream csv;
+  this->timeline.writeCsv(csv);
+
+  std::string line;
+  std::getline(csv, line);
+  ASSERT_EQ("phase,slave,start_us,duration_us,sdo_transfers", line);
+  std::getline(csv, line);
+  ASSERT_EQ(0u, line.find("ec_init,0,"));
+  std::getline(csv, line);
+  ASSERT_EQ(0u, line.find("initialize joint,2,"));
+  ASSERT_EQ(",5", line.substr(line.size() - 2));
+}
+
+TEST_F(StartupTimelineTest, StreamShowsSlavePhases)
+{
+  this->timeline.record("initialize joint", march::StartupTimeline::Clock::now(), 2, 5);
+
+  std::stringstream ss;
+  ss << this->timeline;
+  ASSERT_NE(std::string::npos, ss.str().find("initialize joint (slave 2, 5 SDO transfers)"));
+}
@@ -16,9 +16,11 @@
 #include <march_hardware/ethercat/pdo_interface.h>
 #include <march_hardware/ethercat/sdo_interface.h>
 #include <march_hardware/imotioncube/imotioncube.h>
+#include <march_hardware/imotioncube/setup_image.h>
 #include <march_hardware/joint.h>
 #include <march_hardware/march_robot.h>
 #include <march_hardware/power/power_distribution_board.h>
+#include <march_hardware/realtime_config.h>
 #include <march_hardware/temperature/temperature_ges.h>
 
 /**
@@ -77,6 +79,13 @@ public:
                                                                const urdf::JointConstSharedPtr& urdf_joint,
                                                                march::PdoInterfacePtr pdo_interface,
                                                                march::SdoInterfacePtr sdo_interface);
+  /**
+   * @brief Parses the setup of the .sw file at the given path once, shared by every IMotionCube using that file.
+   * @details Returns nullptr when the file could not be opened.
+   *
+   * @throws HardwareException When the file does not contain a valid setup
+   */
+  static march::SetupImagePtr loadSetupImage(const std::string& sw_path);
   static std::unique_ptr<march::TemperatureGES> createTemperatureGES(const YAML::Node& temperature_ges_config,
                                                                      march::PdoInterfacePtr pdo_interface,
                                                                      march::SdoInterfacePtr sdo_interface);
@@ -84,6 +93,13 @@ public:
   createPowerDistributionBoard(const YAML::Node& power_distribution_board_config, march::PdoInterfacePtr pdo_interface,
                                march::SdoInterfacePtr sdo_interface);
 
+  /**
+   * @brief Creates the real-time settings of a thread from the given config.
+   * @details Keys that are not in the config keep the value of the given defaults.
+   */
+  static march::RealtimeConfig createRealtimeConfig(const YAML::Node& realtime_config,
+                                                    march::RealtimeConfig defaults);
+
   static const std::vector<std::string> INCREMENTAL_ENCODER_REQUIRED_KEYS;
   static const std::vector<std::string> ABSOLUTE_ENCODER_REQUIRED_KEYS;
   static const std::vector<std::string> IMOTIONCUBE_REQUIRED_KEYS;
@@ -112,9 +128,4 @@ private:
   bool init_urdf_ = true;
 };
 
-/**
- * Converts the input filestream object to a stringstream object so that is easier to test for in IMotionCUbe.cpp
- */
-std::string convertSWFileToString(std::ifstream& sw_file);
-
 #endif  // MARCH_HARDWARE_BUILDER_HARDWARE_BUILDER_H
@@ -3,11 +3,12 @@
 #include "march_hardware_builder/hardware_config_exceptions.h"
 
 #include <algorithm>
+#include <fstream>
+#include <map>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
-#include <fstream>
 
 #include <ros/ros.h>
 
@@ -64,16 +65,56 @@ std::unique_ptr<march::MarchRobot> HardwareBuilder::createMarchRobot()
   // Remove top level robot name key
   YAML::Node config = this->robot_config_[robot_name];
   const auto if_name = config["ifName"].as<std::string>();
-  const auto cycle_time = config["ecatCycleTime"].as<int>();
+  const auto cycle_time = config["ecatCycleTimeUs"].as<int>();
   const auto slave_timeout = config["ecatSlaveTimeout"].as<int>();
+  const auto spin_time = config["ecatSpinTimeUs"] ? config["ecatSpinTimeUs"].as<int>() : 0;
+  const auto slow_group_divider = config["ecatSlowGroupDivider"] ? config["ecatSlowGroupDivider"].as<int>() : 1;
 
   std::vector<march::Joint> joints = this->createJoints(config["joints"], pdo_interface, sdo_interface);
 
   ROS_INFO_STREAM("Robot config:\n" << config);
   YAML::Node pdb_config = config["powerDistributionBoard"];
   auto pdb = HardwareBuilder::createPowerDistributionBoard(pdb_config, pdo_interface, sdo_interface);
-  return std::make_unique<march::MarchRobot>(std::move(joints), this->urdf_, std::move(pdb), if_name, cycle_time,
-                                             slave_timeout);
+  auto robot = std::make_unique<march::MarchRobot>(std::move(joints), this->urdf_, std::move(pdb), if_name,
+                                                   cycle_time, slave_timeout, spin_time, slow_group_divider);
+
+  YAML::Node realtime_config = config["realtime"];
+  if (realtime_config)
+  {
+    march::RealtimeConfig ethercat_defaults;
+    ethercat_defaults.priority = march::EthercatMaster::THREAD_PRIORITY;
+    robot->setEthercatRealtimeConfig(
+        HardwareBuilder::createRealtimeConfig(realtime_config["ethercat"], ethercat_defaults));
+    robot->setControllerRealtimeConfig(
+        HardwareBuilder::createRealtimeConfig(realtime_config["controller"], march::RealtimeConfig()));
+  }
+  return robot;
+}
+
+march::RealtimeConfig HardwareBuilder::createRealtimeConfig(const YAML::Node& realtime_config,
+                                                            march::RealtimeConfig defaults)
+{
+  if (!realtime_config)
+  {
+    return defaults;
+  }
+  if (realtime_config["priority"])
+  {
+    defaults.priority = realtime_config["priority"].as<int>();
+  }
+  if (realtime_config["cpus"])
+  {
+    defaults.cpus = realtime_config["cpus"].as<std::vector<int>>();
+  }
+  if (realtime_config["lockMemory"])
+  {
+    defaults.lock_memory = realtime_config["lockMemory"].as<bool>();
+  }
+  if (realtime_config["prefaultStackSize"])
+  {
+    defaults.prefault_stack_size = realtime_config["prefaultStackSize"].as<size_t>();
+  }
+  return defaults;
 }
 
 march::Joint HardwareBuilder::createJoint(const YAML::Node& joint_config, const std::string& joint_name,
@@ -138,13 +179,35 @@ std::unique_ptr<march::IMotionCube> HardwareBuilder::createIMotionCube(const YAM
   YAML::Node absolute_encoder_config = imc_config["absoluteEncoder"];
   int slave_index = imc_config["slaveIndex"].as<int>();
 
-  std::ifstream imc_setup_data;
-  imc_setup_data.open(ros::package::getPath("march_ems_projects").append("/sw_files/" + urdf_joint->name + ".sw"));
-  std::string setup = convertSWFileToString(imc_setup_data);
+  march::SetupImagePtr setup = HardwareBuilder::loadSetupImage(
+      ros::package::getPath("march_ems_projects").append("/sw_files/" + urdf_joint->name + ".sw"));
   return std::make_unique<march::IMotionCube>(
       march::Slave(slave_index, pdo_interface, sdo_interface),
       HardwareBuilder::createAbsoluteEncoder(absolute_encoder_config, urdf_joint),
-      HardwareBuilder::createIncrementalEncoder(incremental_encoder_config), setup, mode);
+      HardwareBuilder::createIncrementalEncoder(incremental_encoder_config), std::move(setup), mode);
+}
+
+march::SetupImagePtr HardwareBuilder::loadSetupImage(const std::string& sw_path)
+{
+  // Setups stay cached as long as any IMotionCube uses them
+  static std::map<std::string, std::weak_ptr<const march::SetupImage>> setup_images;
+  march::SetupImagePtr setup = setup_images[sw_path].lock();
+  if (setup)
+  {
+    return setup;
+  }
+
+  std::ifstream sw_file(sw_path);
+  if (!sw_file.is_open())
+  {
+    ROS_WARN("Failed to open .sw file %s", sw_path.c_str());
+    return nullptr;
+  }
+  setup = std::make_shared<const march::SetupImage>(march::SetupImage::parse(sw_file));
+  ROS_DEBUG("Parsed %zu words of setup with checksum %d from %s", setup->getWords().size(), setup->getChecksum(),
+            sw_path.c_str());
+  setup_images[sw_path] = setup;
+  return setup;
 }
 
 std::unique_ptr<march::AbsoluteEncoder> HardwareBuilder::createAbsoluteEncoder(
@@ -308,8 +371,3 @@ std::vector<march::Joint> HardwareBuilder::createJoints(const YAML::Node& joints
   joints.shrink_to_fit();
   return joints;
 }
-
-std::string convertSWFileToString(std::ifstream& sw_file)
-{
-  return std::string(std::istreambuf_iterator<char>(sw_file), std::istreambuf_iterator<char>());
-}
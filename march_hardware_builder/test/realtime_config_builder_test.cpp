@@ -0,0 +1,62 @@
+// Copyright 2020 Project March.
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <ros/package.h>
+#include <march_hardware_builder/hardware_builder.h>
+
+class RealtimeConfigBuilderTest : public ::testing::Test
+{
+protected:
+  std::string base_path;
+
+  void SetUp() override
+  {
+    base_path = ros::package::getPath("march_hardware_builder").append("/test/yaml/realtime");
+  }
+
+  std::string fullPath(const std::string& relativePath)
+  {
+    return this->base_path.append(relativePath);
+  }
+};
+
+TEST_F(RealtimeConfigBuilderTest, ValidRealtimeConfig)
+{
+  YAML::Node config = YAML::LoadFile(this->fullPath("/realtime_config.yaml"));
+
+  march::RealtimeConfig created = HardwareBuilder::createRealtimeConfig(config, march::RealtimeConfig());
+
+  ASSERT_EQ(45, created.priority);
+  ASSERT_EQ(std::vector<int>({ 2, 3 }), created.cpus);
+  ASSERT_TRUE(created.lock_memory);
+  ASSERT_EQ(524288u, created.prefault_stack_size);
+}
+
+TEST_F(RealtimeConfigBuilderTest, MissingKeysKeepDefaults)
+{
+  YAML::Node config = YAML::LoadFile(this->fullPath("/realtime_config_only_priority.yaml"));
+  march::RealtimeConfig defaults;
+  defaults.cpus = { 1 };
+  defaults.prefault_stack_size = 1024;
+
+  march::RealtimeConfig created = HardwareBuilder::createRealtimeConfig(config, defaults);
+
+  ASSERT_EQ(45, created.priority);
+  ASSERT_EQ(std::vector<int>({ 1 }), created.cpus);
+  ASSERT_FALSE(created.lock_memory);
+  ASSERT_EQ(1024u, created.prefault_stack_size);
+}
+
+TEST_F(RealtimeConfigBuilderTest, NoConfig)
+{
+  YAML::Node config;
+  march::RealtimeConfig defaults;
+  defaults.priority = 40;
+
+  march::RealtimeConfig created = HardwareBuilder::createRealtimeConfig(config["realtime"], defaults);
+
+  ASSERT_EQ(40, created.priority);
+  ASSERT_TRUE(created.cpus.empty());
+}
@@ -5,6 +5,8 @@
 #include "march_hardware_interface/march_temperature_sensor_interface.h"
 #include "march_hardware_interface/power_net_type.h"
 
+#include <exception>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -64,7 +66,7 @@ public:
   void write(const ros::Time& time, const ros::Duration& elapsed_time) override;
 
   /**
-   * Returns the ethercat cycle time in milliseconds.
+   * Returns the ethercat cycle time in microseconds.
    */
   int getEthercatCycleTime() const;
 
@@ -73,6 +75,20 @@ public:
    */
   void waitForPdo();
 
+  /**
+   * Runs the given callback in the ethercat loop after every received PDO, instead of waiting for it with waitForPdo().
+   */
+  void setEthercatCycleCallback(std::function<void()> callback);
+
+  bool isEthercatOperational() const;
+
+  /**
+   * Stops the ethercat loop when it is still running.
+   */
+  void stopEthercat();
+
+  std::exception_ptr getLastEthercatException() const noexcept;
+
 private:
   void uploadJointNames(ros::NodeHandle& nh) const;
   /**
@@ -87,6 +103,10 @@ private:
   void updateIMotionCubeState();
   void outsideLimitsCheck(size_t joint_index);
   bool iMotionCubeStateCheck(size_t joint_index);
+  /**
+   * Logs the start-up timeline and writes it as CSV to the file in the ~startup_timeline_file parameter, if set.
+   */
+  void reportStartupTimeline();
   static void getSoftJointLimitsError(const std::string& name, const urdf::JointConstSharedPtr& urdf_joint,
                                       joint_limits_interface::SoftJointLimits& error_soft_limits);
 
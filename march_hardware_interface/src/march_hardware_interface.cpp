@@ -5,9 +5,13 @@
 #include <algorithm>
 #include <cmath>
 #include <exception>
+#include <fstream>
+#include <functional>
 #include <memory>
 #include <sstream>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <joint_limits_interface/joint_limits.h>
 #include <joint_limits_interface/joint_limits_interface.h>
@@ -16,6 +20,7 @@
 
 #include <march_hardware/imotioncube/actuation_mode.h>
 #include <march_hardware/joint.h>
+#include <march_hardware/robot_state.h>
 
 using hardware_interface::JointHandle;
 using hardware_interface::JointStateHandle;
@@ -73,6 +78,7 @@ bool MarchHardwareInterface::init(ros::NodeHandle& nh, ros::NodeHandle& /* robot
                                                &power_net_on_off_command_);
     march_pdb_interface_.registerHandle(march_pdb_state_handle);
 
+    const auto high_voltage_start_time = march::StartupTimeline::Clock::now();
     for (const auto& joint : *this->march_robot_)
     {
       const int net_number = joint.getNetNumber();
@@ -89,6 +95,7 @@ bool MarchHardwareInterface::init(ros::NodeHandle& nh, ros::NodeHandle& /* robot
         ROS_WARN("[%s] Waiting on high voltage", joint.getName().c_str());
       }
     }
+    this->march_robot_->getStartupTimeline().record("enable high voltage", high_voltage_start_time);
 
     this->registerInterface(&this->march_pdb_interface_);
   }
@@ -97,6 +104,9 @@ bool MarchHardwareInterface::init(ros::NodeHandle& nh, ros::NodeHandle& /* robot
     ROS_WARN("Running without Power Distribution Board");
   }
 
+  // Enable high voltage on the IMCs of all joints at the same time
+  this->march_robot_->prepareActuation();
+
   // Initialize interfaces for each joint
   for (size_t i = 0; i < num_joints_; ++i)
   {
@@ -140,11 +150,8 @@ bool MarchHardwareInterface::init(ros::NodeHandle& nh, ros::NodeHandle& /* robot
                                                            &joint_temperature_variance_[i]);
     march_temperature_interface_.registerHandle(temperature_sensor_handle);
 
-    // Enable high voltage on the IMC
     if (joint.canActuate())
     {
-      joint.prepareActuation();
-
       // Set the first target as the current position
       joint_position_[i] = joint.getPosition();
       joint_velocity_[i] = joint.getVelocity();
@@ -169,9 +176,28 @@ bool MarchHardwareInterface::init(ros::NodeHandle& nh, ros::NodeHandle& /* robot
   this->registerInterface(&this->position_joint_soft_limits_interface_);
   this->registerInterface(&this->effort_joint_soft_limits_interface_);
 
+  this->reportStartupTimeline();
+
   return true;
 }
 
+void MarchHardwareInterface::reportStartupTimeline()
+{
+  const march::StartupTimeline& timeline = this->march_robot_->getStartupTimeline();
+  ROS_INFO_STREAM(timeline);
+
+  const std::string file_name = ros::param::param<std::string>("~startup_timeline_file", "");
+  if (!file_name.empty())
+  {
+    std::ofstream file(file_name);
+    timeline.writeCsv(file);
+    if (!file)
+    {
+      ROS_WARN("Failed to write the start-up timeline to %s", file_name.c_str());
+    }
+  }
+}
+
 void MarchHardwareInterface::validate()
 {
   const auto last_exception = this->march_robot_->getLastEthercatException();
@@ -201,22 +227,45 @@ void MarchHardwareInterface::waitForPdo()
   this->march_robot_->waitForPdo();
 }
 
-void MarchHardwareInterface::read(const ros::Time& /* time */, const ros::Duration& elapsed_time)
+void MarchHardwareInterface::setEthercatCycleCallback(std::function<void()> callback)
 {
-  for (size_t i = 0; i < num_joints_; i++)
+  this->march_robot_->setEthercatCycleCallback(std::move(callback));
+}
+
+bool MarchHardwareInterface::isEthercatOperational() const
+{
+  return this->march_robot_->isEthercatOperational();
+}
+
+void MarchHardwareInterface::stopEthercat()
+{
+  if (this->march_robot_->isEthercatOperational())
   {
-    march::Joint& joint = march_robot_->getJoint(i);
+    this->march_robot_->stopEtherCAT();
+  }
+}
 
-    // Update position with he most accurate velocity
-    joint.readEncoders(elapsed_time);
-    joint_position_[i] = joint.getPosition();
-    joint_velocity_[i] = joint.getVelocity();
+std::exception_ptr MarchHardwareInterface::getLastEthercatException() const noexcept
+{
+  return this->march_robot_->getLastEthercatException();
+}
 
-    if (joint.hasTemperatureGES())
+void MarchHardwareInterface::read(const ros::Time& /* time */, const ros::Duration& elapsed_time)
+{
+  // Update positions with the most accurate velocities of all joints at once
+  const march::RobotState& state = this->march_robot_->updateRobotState(elapsed_time.toSec());
+  const std::vector<double>& effort = state.get(march::RobotState::Quantity::Effort);
+  std::copy(state.getPositions().begin(), state.getPositions().end(), joint_position_.begin());
+  std::copy(state.getVelocities().begin(), state.getVelocities().end(), joint_velocity_.begin());
+  std::copy(effort.begin(), effort.end(), joint_effort_.begin());
+
+  const std::vector<double>& temperatures = state.getTemperatures();
+  for (size_t i = 0; i < num_joints_; i++)
+  {
+    if (march_robot_->getJoint(i).hasTemperatureGES())
     {
-      joint_temperature_[i] = joint.getTemperature();
+      joint_temperature_[i] = temperatures[i];
     }
-    joint_effort_[i] = joint.getTorque();
   }
 
   this->updateIMotionCubeState();
@@ -462,10 +511,13 @@ void MarchHardwareInterface::updateIMotionCubeState()
 
 bool MarchHardwareInterface::iMotionCubeStateCheck(size_t joint_index)
 {
-  march::Joint& joint = march_robot_->getJoint(joint_index);
-  march::IMotionCubeState imc_state = joint.getIMotionCubeState();
-  if (imc_state.state == march::IMCState::FAULT)
+  const march::RobotState& state = this->march_robot_->getRobotState();
+  const uint16_t status_word = state.get(march::RobotState::Register::StatusWord)[joint_index];
+  if (march::IMCState(status_word) == march::IMCState::FAULT)
   {
+    // Only parse the error registers when they are reported
+    march::Joint& joint = march_robot_->getJoint(joint_index);
+    march::IMotionCubeState imc_state = joint.getIMotionCubeState();
     ROS_ERROR("IMotionCube of joint %s is in fault state %s"
               "\nMotion Error: %s (%s)"
               "\nDetailed Error: %s (%s)"
@@ -2,11 +2,15 @@
 #include "march_hardware_interface/march_hardware_interface.h"
 
 #include <cstdlib>
+#include <exception>
+#include <memory>
+#include <utility>
 
 #include <controller_manager/controller_manager.h>
 #include <ros/ros.h>
 
 #include <march_hardware/march_robot.h>
+#include <march_hardware/realtime_config.h>
 #include <march_hardware/error/hardware_exception.h>
 #include <march_hardware_builder/hardware_builder.h>
 
@@ -27,10 +31,13 @@ int main(int argc, char** argv)
   ROS_INFO_STREAM("Selected robot: " << selected_robot);
 
   bool reset_imc = ros::param::param<bool>("~reset_imc", false);
+  bool synchronous_control = ros::param::param<bool>("~synchronous_control", false);
 
   spinner.start();
 
-  MarchHardwareInterface march(build(selected_robot), reset_imc);
+  std::unique_ptr<march::MarchRobot> robot = build(selected_robot);
+  const march::RealtimeConfig controller_realtime_config = robot->getControllerRealtimeConfig();
+  MarchHardwareInterface march(std::move(robot), reset_imc);
 
   try
   {
@@ -50,20 +57,63 @@ int main(int argc, char** argv)
   controller_manager::ControllerManager controller_manager(&march, nh);
   ros::Time last_update_time = ros::Time::now();
 
+  const auto update = [&]() {
+    const ros::Time now = ros::Time::now();
+    ros::Duration elapsed_time = now - last_update_time;
+    last_update_time = now;
+
+    march.read(now, elapsed_time);
+    march.validate();
+    controller_manager.update(now, elapsed_time);
+    march.write(now, elapsed_time);
+  };
+
+  if (synchronous_control)
+  {
+    // Runs the update inside the ethercat loop, so the commands are sent in the cycle directly after the inputs
+    ROS_INFO("Running the controllers synchronously in the EtherCAT loop");
+    march.setEthercatCycleCallback(update);
+    while (ros::ok() && march.isEthercatOperational())
+    {
+      ros::Duration(0.1).sleep();
+    }
+
+    int exit_code = 0;
+    const std::exception_ptr exception = march.getLastEthercatException();
+    if (exception)
+    {
+      try
+      {
+        std::rethrow_exception(exception);
+      }
+      catch (const std::exception& e)
+      {
+        ROS_FATAL("Hardware interface caught an exception during update");
+        ROS_FATAL("%s", e.what());
+        exit_code = 1;
+      }
+      catch (...)
+      {
+        // The cycle callback may throw anything, which must not end the node without stopping the loop
+        ROS_FATAL("Hardware interface caught an unknown exception during update");
+        exit_code = 1;
+      }
+    }
+    // Stop the loop before the controller manager used by the update is destroyed
+    march.stopEthercat();
+    return exit_code;
+  }
+
+  // Applied after init, so only the controller thread and not the threads started during init get these settings
+  const march::RealtimeReport realtime_report = march::applyRealtimeConfig(controller_realtime_config);
+  ROS_INFO_STREAM("Controller thread real-time settings: " << realtime_report);
+
   while (ros::ok())
   {
     try
     {
       march.waitForPdo();
-
-      const ros::Time now = ros::Time::now();
-      ros::Duration elapsed_time = now - last_update_time;
-      last_update_time = now;
-
-      march.read(now, elapsed_time);
-      march.validate();
-      controller_manager.update(now, elapsed_time);
-      march.write(now, elapsed_time);
+      update();
     }
     catch (const std::exception& e)
     {